@@ -113,6 +113,87 @@ static void handle_sigusr(int sig) {
 }
 #endif
 
+ring* database::new_ring() {
+    std::lock_guard<std::mutex> guard(m_mtx);
+    m_rings.emplace_back(new ring());
+    return m_rings.back().get();
+}
+
+ring* database::local_ring() {
+    // rings stay owned by the database, so entries of threads that have
+    // already exited are still written out by the worker
+    thread_local database* owner = nullptr;
+    thread_local ring* local = nullptr;
+    if (owner != this) {
+        local = new_ring();
+        owner = this;
+    }
+
+    return local;
+}
+
+void database::push(const entry& e) {
+    ring* r = local_ring();
+    if (!r->push(e))
+        push_slow(r, e);
+    else if (m_sleeping.load(std::memory_order_relaxed) &&
+             r->size() >= ring::CAPACITY / 4)
+        wakeup();
+}
+
+void database::push_slow(ring* r, const entry& e) {
+    if (!m_nodrop && entry_droppable(e.kind)) {
+        r->count_drop();
+        return;
+    }
+
+    m_stalls++;
+    do {
+        if (!m_running) {
+            r->count_drop();
+            return;
+        }
+
+        wakeup();
+        std::this_thread::yield();
+    } while (!r->push(e));
+}
+
+void database::wakeup() {
+    std::lock_guard<std::mutex> guard(m_mtx);
+    m_cv.notify_one();
+}
+
+size_t database::dropped() const {
+    std::lock_guard<std::mutex> guard(m_mtx);
+    size_t n = 0;
+    for (const auto& r : m_rings)
+        n += r->dropped();
+    return n;
+}
+
+size_t database::drain(size_t limit) {
+    std::vector<ring*> rings;
+    m_mtx.lock();
+    for (const auto& r : m_rings)
+        rings.push_back(r.get());
+    m_mtx.unlock();
+
+    size_t total = 0;
+    for (ring* r : rings)
+        total += std::min(r->size(), limit);
+
+    if (total == 0)
+        return 0;
+
+    begin(total);
+    for (ring* r : rings)
+        r->drain(limit, [&](const entry& e) -> void { process(e); });
+    end(total);
+
+    return total;
+}
+
 void database::work() {
     init();
 
@@ -124,27 +205,20 @@ void database::work() {
     info.pid = getpid();
     gen_meta(info);
 
+    const size_t batch = ring::CAPACITY / 2;
     while (true) {
-        m_mtx.lock();
-        m_cv.wait(m_mtx, [&]() -> bool {
-            return !m_running || !m_entries.empty();
-        });
+        bool running = m_running;
+        if (drain(batch) > 0)
+            continue;
 
-        std::vector<entry> copy;
-        m_entries.swap(copy);
-        m_mtx.unlock();
-
-        if (!copy.empty()) {
-            begin(copy.size());
-
-            for (const entry& e : copy)
-                process(e);
-
-            end(copy.size());
-        }
-
-        if (!m_running)
+        if (!running)
             return;
+
+        // producers only wake us if their rings fill up, otherwise we poll
+        std::unique_lock<std::mutex> lock(m_mtx);
+        m_sleeping = true;
+        m_cv.wait_for(lock, std::chrono::milliseconds(1));
+        m_sleeping = false;
     }
 }
 
@@ -280,17 +354,26 @@ void database::start() {
 void database::stop() {
     if (m_worker.joinable()) {
         m_running = false;
-        m_cv.notify_all();
+        wakeup();
         m_worker.join();
+
+        size_t n = dropped();
+        if (n > 0 || m_stalls > 0) {
+            fprintf(stderr, "INSCIGHT: dropped %zu scheduler entries, "
+                    "stalled %zu times\n", n, (size_t)m_stalls);
+        }
     }
 }
 
 database::database(const std::string& options):
     m_enabled(true),
     m_running(),
+    m_sleeping(),
+    m_stalls(),
+    m_nodrop(options.find("nodrop") != std::string::npos),
     m_mtx(),
     m_cv(),
-    m_entries(),
+    m_rings(),
     m_worker() {
 #ifdef __linux__
     signal(SIGUSR2, handle_sigusr);
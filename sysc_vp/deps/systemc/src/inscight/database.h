@@ -18,22 +18,87 @@
 #include <mutex>
 #include <thread>
 #include <condition_variable>
+#include <memory>
+#include <algorithm>
 
 #include "inscight/entry.h"
 
 namespace inscight {
 
+// Single-producer single-consumer ring of trace entries. Each thread that
+// inserts into the database owns one ring, the database worker thread is
+// the only consumer. Head and tail live on separate cache lines so that
+// producer and consumer do not contend on the same line.
+class ring
+{
+public:
+    static constexpr size_t CAPACITY = 1u << 15;
+
+    ring(): m_head(0), m_tail(0), m_dropped(0) {}
+
+    size_t size() const {
+        return m_head.load(std::memory_order_acquire) -
+               m_tail.load(std::memory_order_relaxed);
+    }
+
+    bool push(const entry& e) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= CAPACITY)
+            return false;
+        m_entries[head % CAPACITY] = e;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename FN>
+    size_t drain(size_t limit, FN&& fn) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t head = m_head.load(std::memory_order_acquire);
+        size_t n = std::min(head - tail, limit);
+        for (size_t i = 0; i < n; i++)
+            fn(m_entries[(tail + i) % CAPACITY]);
+        m_tail.store(tail + n, std::memory_order_release);
+        return n;
+    }
+
+    void count_drop() { m_dropped.fetch_add(1, std::memory_order_relaxed); }
+    size_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t PAD = 64 - sizeof(std::atomic<size_t>);
+
+    std::atomic<size_t> m_head;
+    char m_pad0[PAD];
+    std::atomic<size_t> m_tail;
+    char m_pad1[PAD];
+    std::atomic<size_t> m_dropped;
+    char m_pad2[PAD];
+    entry m_entries[CAPACITY];
+};
+
 class database
 {
 protected:
     std::atomic<bool> m_enabled;
     std::atomic<bool> m_running;
+    std::atomic<bool> m_sleeping;
+    std::atomic<size_t> m_stalls;
+    bool m_nodrop;
 
-    std::mutex m_mtx;
-    std::condition_variable_any m_cv;
-    std::vector<entry> m_entries;
+    mutable std::mutex m_mtx;
+    std::condition_variable m_cv;
+    std::vector<std::unique_ptr<ring>> m_rings;
     std::thread m_worker;
 
+    ring* local_ring();
+    ring* new_ring();
+
+    void push(const entry& e);
+    void push_slow(ring* r, const entry& e);
+    void wakeup();
+
+    size_t drain(size_t limit);
+
     void gen_meta();
 
     void work();
@@ -89,12 +154,12 @@ protected:
 public:
     template <typename... ARGS>
     void insert(ARGS&&... args) {
-        m_mtx.lock();
-        m_entries.emplace_back(std::forward<ARGS>(args)...);
-        m_mtx.unlock();
-        m_cv.notify_one();
+        push(entry(std::forward<ARGS>(args)...));
     }
 
+    size_t dropped() const;
+    size_t stalls() const { return m_stalls; }
+
     void start();
     void stop();
 
@@ -104,6 +104,25 @@ enum entry_kind {
     LOG_MESSAGE,
 };
 
+// Scheduler activity is traced at very high rates and carries no heap
+// allocated strings, so such entries may be dropped if the database writer
+// cannot keep up, whereas all other entries apply backpressure instead.
+inline bool entry_droppable(entry_kind kind) {
+    switch (kind) {
+    case PROCESS_START:
+    case PROCESS_YIELD:
+    case EVENT_NOTIFY_IMMEDIATE:
+    case EVENT_NOTIFY_DELTA:
+    case EVENT_NOTIFY_TIMED:
+    case EVENT_CANCEL:
+    case CHANNEL_UPDATE_START:
+    case CHANNEL_UPDATE_COMPLETE:
+        return true;
+    default:
+        return false;
+    }
+}
+
 struct entry {
     entry_kind kind;
     id_t id;
@@ -112,6 +131,8 @@ struct entry {
     uintptr_t arg2;
     uintptr_t arg3;
 
+    entry() = default;
+
     template <typename A = uintptr_t, typename B = uintptr_t,
               typename C = uintptr_t, typename D = uintptr_t>
     entry(entry_kind k, id_t obj, A a = A(), B b = B(), C c = C(), D d = D()):
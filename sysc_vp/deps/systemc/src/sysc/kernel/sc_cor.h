@@ -69,6 +69,9 @@ public:
     // switch stack protection on/off
     virtual void stack_protect( bool /* enable */ ) {}
 
+    // number of stack bytes touched so far, zero if unknown
+    virtual std::size_t stack_usage() const { return 0; }
+
 private:
 
     // disabled
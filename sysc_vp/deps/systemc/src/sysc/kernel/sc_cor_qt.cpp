@@ -32,6 +32,9 @@
 #include <sys/mman.h>
 #include <sys/types.h>
 
+#include <utility>
+#include <vector>
+
 #include "sysc/kernel/sc_cor_qt.h"
 #include "sysc/kernel/sc_simcontext.h"
 
@@ -49,6 +52,28 @@ static sc_cor_qt main_cor;
 
 static sc_cor_qt* curr_cor = 0;
 
+// stacks of terminated coroutines, kept for reuse
+
+static const std::size_t MAX_POOLED_STACKS = 64;
+
+static std::vector< std::pair<void*, std::size_t> > stack_pool;
+
+static std::size_t page_size()
+{
+    static std::size_t pagesize;
+
+    if( pagesize == 0 ) {
+#       if defined(__ppc__)
+	    pagesize = getpagesize();
+#       else
+	    pagesize = sysconf( _SC_PAGESIZE );
+#       endif
+    }
+
+    sc_assert( pagesize != 0 );
+    return pagesize;
+}
+
 // ----------------------------------------------------------------------------
 //  Sanitizer helpers
 // ----------------------------------------------------------------------------
@@ -127,6 +152,17 @@ void sanitizer_finish_switch( sc_cor_qt* next, void* context_save ) {
 //  Coroutine class implemented with QuickThreads.
 // ----------------------------------------------------------------------------
 
+// destructor
+
+sc_cor_qt::~sc_cor_qt()
+{
+#ifdef HAVE_VALGRIND_H
+    VALGRIND_STACK_DEREGISTER(m_vgid);
+#endif
+    if( m_stack )
+        sc_cor_pkg_qt::free_stack( m_stack, m_map_size );
+}
+
 // switch stack protection on/off
 
 void
@@ -135,17 +171,7 @@ sc_cor_qt::stack_protect( bool enable )
     // Code needs to be tested on HP-UX and disabled if it doesn't work there
     // Code still needs to be ported to WIN32
 
-    static std::size_t pagesize;
-
-    if( pagesize == 0 ) {
-#       if defined(__ppc__)
-	    pagesize = getpagesize();
-#       else
-	    pagesize = sysconf( _SC_PAGESIZE );
-#       endif
-    }
-
-    sc_assert( pagesize != 0 );
+    std::size_t pagesize = page_size();
     sc_assert( m_stack_size > ( 2 * pagesize ) );
 
 #ifdef QUICKTHREADS_GROW_DOWN
@@ -180,6 +206,37 @@ sc_cor_qt::stack_protect( bool enable )
     sc_assert( ret == 0 );
 }
 
+// number of stack bytes touched so far: stack pages are only committed on
+// first access, so the extent of resident pages marks the high-water mark
+
+std::size_t
+sc_cor_qt::stack_usage() const
+{
+#if defined(__linux__)
+    if( m_stack == 0 )
+        return 0;
+
+    std::size_t pagesize = page_size();
+    std::size_t npages = m_map_size / pagesize;
+    std::vector<unsigned char> resident( npages );
+    if( mincore( m_stack, npages * pagesize, &resident[0] ) != 0 )
+        return 0;
+
+#ifdef QUICKTHREADS_GROW_DOWN
+    for( std::size_t i = 0; i < npages; ++ i ) {
+        if( resident[i] & 1 )
+            return ( npages - i ) * pagesize;
+    }
+#else
+    for( std::size_t i = npages; i > 0; -- i ) {
+        if( resident[i - 1] & 1 )
+            return i * pagesize;
+    }
+#endif
+#endif // __linux__
+    return 0;
+}
+
 
 // ----------------------------------------------------------------------------
 //  CLASS : sc_cor_pkg_qt
@@ -251,8 +308,8 @@ sc_cor_pkg_qt::create( std::size_t stack_size, sc_cor_fn* fn, void* arg )
     sc_cor_qt* cor = new sc_cor_qt();
     cor->m_pkg = this;
     cor->m_stack_size = stack_size;
-    cor->m_stack = mmap(NULL, cor->m_stack_size, PROT_READ | PROT_WRITE,
-                        MAP_PRIVATE | MAP_ANON, -1, 0);
+    cor->m_map_size = stack_size;
+    cor->m_stack = alloc_stack( cor->m_map_size );
 
 #ifdef HAVE_VALGRIND_H
     cor->m_vgid = VALGRIND_STACK_REGISTER(cor->m_stack, (char*)cor->m_stack + cor->m_stack_size - 1);
@@ -324,6 +381,57 @@ sc_cor_pkg_qt::get_main()
     return &main_cor;
 }
 
+
+// stack pool
+
+void*
+sc_cor_pkg_qt::alloc_stack( std::size_t size )
+{
+    for( std::size_t i = stack_pool.size(); i > 0; -- i ) {
+        if( stack_pool[i - 1].second == size ) {
+            void* stack = stack_pool[i - 1].first;
+            stack_pool.erase( stack_pool.begin() + ( i - 1 ) );
+            return stack;
+        }
+    }
+
+    // only reserve address space, pages get committed on first touch
+    int flags = MAP_PRIVATE | MAP_ANON;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+#ifdef MAP_STACK
+    flags |= MAP_STACK;
+#endif
+
+    void* stack = mmap( NULL, size, PROT_READ | PROT_WRITE, flags, -1, 0 );
+    sc_assert( stack != MAP_FAILED );
+    return stack;
+}
+
+void
+sc_cor_pkg_qt::free_stack( void* stack, std::size_t size )
+{
+    // sanitizers keep shadow state for stacks, so do not recycle them
+    if( sanitizer_present() || stack_pool.size() >= MAX_POOLED_STACKS ) {
+        munmap( stack, size );
+        return;
+    }
+
+    // drop the old contents, so that the pages are released and the
+    // stack usage of the next owner starts from zero again
+#ifdef MADV_DONTNEED
+    madvise( stack, size, MADV_DONTNEED );
+#endif
+    stack_pool.push_back( std::make_pair( stack, size ) );
+}
+
+std::size_t
+sc_cor_pkg_qt::pooled_stacks()
+{
+    return stack_pool.size();
+}
+
 } // namespace sc_core
 
 #endif
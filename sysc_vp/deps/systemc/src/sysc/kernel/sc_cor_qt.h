@@ -33,8 +33,6 @@
 
 #if !defined(_WIN32) && !defined(WIN32) && !defined(WIN64)  && !defined(SC_USE_PTHREADS)
 
-#include <sys/mman.h> // for munmap
-
 #ifdef HAVE_VALGRIND_H
 #include <valgrind/valgrind.h>
 #endif
@@ -60,27 +58,26 @@ public:
 
     // constructor
     sc_cor_qt()
-	: m_stack_size( 0 ), m_stack( 0 ), m_sp( 0 ), m_pkg( 0 )
+	: m_stack_size( 0 ), m_map_size( 0 ), m_stack( 0 ), m_sp( 0 ),
+	  m_pkg( 0 )
 #ifdef HAVE_VALGRIND_H
     , m_vgid( 0 )
 #endif
 	{}
 
     // destructor
-    virtual ~sc_cor_qt() {
-#ifdef HAVE_VALGRIND_H
-        VALGRIND_STACK_DEREGISTER(m_vgid);
-#endif
-        if (m_stack)
-            munmap(m_stack, m_stack_size);
-    }
+    virtual ~sc_cor_qt();
 
     // switch stack protection on/off
     virtual void stack_protect( bool enable );
 
+    // number of stack bytes touched so far
+    virtual std::size_t stack_usage() const;
+
 public:
 
     std::size_t    m_stack_size;  // stack size
+    std::size_t    m_map_size;    // size of the stack mapping
     void*          m_stack;       // stack
     qt_t*          m_sp;          // stack pointer
 
@@ -127,6 +124,12 @@ public:
     // get the main coroutine
     virtual sc_cor* get_main();
 
+    // stack pool: stacks of terminated coroutines are kept for reuse by
+    // later coroutines of the same stack size
+    static void* alloc_stack( std::size_t size );
+    static void  free_stack( void* stack, std::size_t size );
+    static std::size_t pooled_stacks();
+
 private:
 
     static int instance_count;
@@ -79,8 +79,7 @@ sc_event::cancel()
     case TIMED: {
         // remove this event from the timed events set
         sc_assert( m_timed != 0 );
-        m_timed->m_event = 0;
-        m_timed = 0;
+        m_simc->remove_timed_event( m_timed );
         m_notify_type = NONE;
         if (sc_is_running(m_simc)) {
             INSCIGHT_EVENT_CANCEL(id());
@@ -134,8 +133,7 @@ sc_event::notify( const sc_time& t )
         if( m_notify_type == TIMED ) {
             // remove this event from the timed events set
             sc_assert( m_timed != 0 );
-            m_timed->m_event = 0;
-            m_timed = 0;
+            m_simc->remove_timed_event( m_timed );
         }
         // add this event to the delta events set
         m_delta_event_index = m_simc->add_delta_event( this );
@@ -162,8 +160,7 @@ sc_event::notify( const sc_time& t )
             return;
         }
         // remove this event from the timed events set
-        m_timed->m_event = 0;
-        m_timed = 0;
+        m_simc->remove_timed_event( m_timed );
     }
     // add this event to the timed events set
     sc_event_timed* et = new sc_event_timed( this, m_simc->time_stamp() + t );
@@ -364,13 +364,14 @@ class SC_API sc_event_timed
 {
     friend class sc_event;
     friend class sc_simcontext;
+    template <class T, int D> friend class sc_dpq;
 
     friend SC_API int sc_notify_time_compare( const void*, const void* );
 
 private:
 
     sc_event_timed( sc_event* e, const sc_time& t )
-        : m_event( e ), m_notify_time( t )
+        : m_event( e ), m_notify_time( t ), m_order( 0 ), m_heap_index( -1 )
         {}
 
     ~sc_event_timed()
@@ -382,6 +383,13 @@ private:
     const sc_time& notify_time() const
         { return m_notify_time; }
 
+    // earlier time first, notifications for the same time in FIFO order
+    static bool heap_before( const sc_event_timed* a,
+                             const sc_event_timed* b )
+        { return a->m_notify_time < b->m_notify_time ||
+                 ( a->m_notify_time == b->m_notify_time &&
+                   a->m_order < b->m_order ); }
+
     static void* operator new( std::size_t )
         { return allocate(); }
 
@@ -396,8 +404,10 @@ private:
 
 private:
 
-    sc_event* m_event;
-    sc_time   m_notify_time;
+    sc_event*     m_event;
+    sc_time       m_notify_time;
+    sc_dt::uint64 m_order;      // insertion order, breaks ties
+    int           m_heap_index; // position in the timed event queue
 
 private:
 
@@ -410,6 +420,22 @@ private:
 
 // IIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIIII
 
+inline
+void
+sc_simcontext::add_timed_event( sc_event_timed* et )
+{
+    et->m_order = m_timed_event_order++;
+    m_timed_events->insert( et );
+}
+
+inline
+void
+sc_simcontext::remove_timed_event( sc_event_timed* et )
+{
+    m_timed_events->remove( et );
+    delete et;
+}
+
 inline
 void
 sc_event::notify( double v, sc_time_unit tu )
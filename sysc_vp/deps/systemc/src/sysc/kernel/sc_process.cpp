@@ -582,6 +582,9 @@ sc_process_b::sc_process_b( const char* name_p, bool is_thread, bool free_host,
     m_timeout_event_p(0),
     m_trigger_type(STATIC),
     m_unwinding(false)
+#ifdef SC_ENABLE_PROCESS_PROFILING
+    , m_prof_runs(0), m_prof_host_ns(0)
+#endif
 {
     // Check spawn phase: m_ready_to_simulate is set *after* elaboration_done()
     unsigned spawned = SPAWN_ELAB;
@@ -34,6 +34,7 @@
 #include "sysc/kernel/sc_constants.h"
 #include "sysc/kernel/sc_object.h"
 #include "sysc/kernel/sc_kernel_ids.h"
+#include "sysc/datatypes/int/sc_nbdefs.h"
 #include "sysc/communication/sc_export.h"
 
 #if defined(_MSC_VER) && !defined(SC_WIN_DLL_WARN)
@@ -470,6 +471,11 @@ class SC_API sc_process_b : public sc_object {
     trigger_t                    m_trigger_type;    // type of trigger using.
     bool                         m_unwinding;       // true if unwinding stack.
 
+#ifdef SC_ENABLE_PROCESS_PROFILING
+    sc_dt::uint64                m_prof_runs;       // number of activations.
+    sc_dt::uint64                m_prof_host_ns;    // host time spent running.
+#endif
+
   protected:
     static sc_process_b* m_last_created_process_p; // Last process created.
 };
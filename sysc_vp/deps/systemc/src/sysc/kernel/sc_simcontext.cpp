@@ -58,7 +58,10 @@
 #include "sysc/utils/sc_utils_ids.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <iomanip>
+#include <iostream>
 #include <sstream>
 
 // DEBUGGING MACROS:
@@ -338,7 +341,16 @@ sc_simcontext::init()
 
     reset_curr_proc();
     m_next_proc_id = -1;
-    m_timed_events = new sc_ppq<sc_event_timed*>( 128, sc_notify_time_compare );
+    m_timed_events = new sc_dpq<sc_event_timed>( 128 );
+    m_timed_event_order = 0;
+#ifdef SC_ENABLE_PROCESS_PROFILING
+    m_prof_curr = 0;
+    m_prof_start_ns = 0;
+    m_prof_timesteps = 0;
+    m_prof_deltas = 0;
+    m_prof_max_deltas = 0;
+    m_prof_max_time = SC_ZERO_TIME;
+#endif
     m_something_to_trace = false;
     m_runnable = new sc_runnable;
     m_collectable = new sc_process_list;
@@ -376,6 +388,11 @@ sc_simcontext::clean()
     delete m_time_params;
     delete m_collectable;
     delete m_runnable;
+    while( !m_timed_events->empty() ) {
+        sc_event_timed* et = m_timed_events->extract_top();
+        et->event()->m_notify_type = sc_event::NONE;
+        delete et;
+    }
     delete m_timed_events;
     delete m_process_table;
     delete m_name_gen;
@@ -405,6 +422,7 @@ sc_simcontext::sc_simcontext() :
     m_process_table(0), m_curr_proc_info(), m_current_writer(0),
     m_write_check(SC_SIGNAL_WRITE_CHECK_DEFAULT_), m_next_proc_id(-1),
     m_child_events(), m_child_objects(), m_delta_events(), m_timed_events(0),
+    m_timed_event_order(0),
     m_trace_files(), m_something_to_trace(false), m_runnable(0), m_collectable(0),
     m_time_params(), m_curr_time(SC_ZERO_TIME), m_max_time(SC_ZERO_TIME),
     m_change_stamp(0), m_delta_count(0), m_initial_delta_count_at_current_time(0),
@@ -919,9 +937,7 @@ sc_simcontext::simulate( const sc_time& duration )
 		sc_event_timed* et = m_timed_events->extract_top();
 		sc_event* e = et->event();
 		delete et;
-		if( e != 0 ) {
-		    e->trigger();
-		}
+		e->trigger();
 	    } while( m_timed_events->size() &&
 		     m_timed_events->top()->notify_time() == t );
 
@@ -950,6 +966,16 @@ sc_simcontext::do_timestep(const sc_time& t)
     }
 #endif
 
+#ifdef SC_ENABLE_PROCESS_PROFILING
+    sc_dt::uint64 deltas = m_delta_count - m_initial_delta_count_at_current_time;
+    if( deltas > m_prof_max_deltas ) {
+        m_prof_max_deltas = deltas;
+        m_prof_max_time = m_curr_time;
+    }
+    m_prof_deltas += deltas;
+    m_prof_timesteps++;
+#endif
+
     m_curr_time = t;
     m_change_stamp++;
     m_initial_delta_count_at_current_time = m_delta_count;
@@ -1038,6 +1064,186 @@ sc_simcontext::end()
     m_module_registry->simulation_done();
     SC_DO_PHASE_CALLBACK_(simulation_done);
     m_end_of_simulation_called = true;
+
+    // report stack high-water marks to help right-sizing thread stacks
+    if( std::getenv( "SC_STACK_USAGE" ) != NULL )
+        print_stack_usage( ::std::cout );
+}
+
+void
+sc_simcontext::print_stack_usage( ::std::ostream& os ) const
+{
+    os << "thread stack usage:" << ::std::endl;
+    for( sc_thread_handle thread_p = m_process_table->thread_q_head();
+         thread_p; thread_p = thread_p->next_exist() ) {
+        std::size_t size = thread_p->stack_size();
+        std::size_t used = thread_p->stack_usage();
+        os << "  " << thread_p->name() << ": " << used << " of " << size
+           << " bytes (" << ( size ? used * 100 / size : 0 ) << "%)"
+           << ::std::endl;
+    }
+}
+
+SC_API void
+sc_print_stack_usage( ::std::ostream& os )
+{
+    sc_get_curr_simcontext()->print_stack_usage( os );
+}
+
+// +----------------------------------------------------------------------------
+// |"sc_simcontext::profile_switch"
+// |
+// | Charges the host time since the last process switch to the process that
+// | ran until now. Called whenever the current process changes, which is
+// | also the point where threads switch coroutines.
+// +----------------------------------------------------------------------------
+#ifdef SC_ENABLE_PROCESS_PROFILING
+static inline sc_dt::uint64 host_time_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+void
+sc_simcontext::profile_switch( sc_process_b* next )
+{
+    if( next == m_prof_curr )
+        return;
+
+    sc_dt::uint64 now = host_time_ns();
+    if( m_prof_curr != 0 )
+        m_prof_curr->m_prof_host_ns += now - m_prof_start_ns;
+
+    m_prof_curr = next;
+    m_prof_start_ns = now;
+}
+#endif
+
+static bool
+sc_profile_before( const sc_process_profile& a, const sc_process_profile& b )
+{
+    return a.host_time_ns > b.host_time_ns;
+}
+
+std::vector<sc_process_profile>
+sc_simcontext::process_profile() const
+{
+    std::vector<sc_process_profile> profile;
+#ifdef SC_ENABLE_PROCESS_PROFILING
+    std::vector<sc_process_b*> procs;
+    for( sc_method_handle method_p = m_process_table->method_q_head();
+         method_p; method_p = method_p->next_exist() )
+        procs.push_back( method_p );
+    for( sc_thread_handle thread_p = m_process_table->thread_q_head();
+         thread_p; thread_p = thread_p->next_exist() )
+        procs.push_back( thread_p );
+
+    for( std::size_t i = 0; i < procs.size(); ++ i ) {
+        sc_process_profile entry;
+        entry.name = procs[i]->name();
+        entry.kind = procs[i]->proc_kind();
+        entry.activations = procs[i]->m_prof_runs;
+        entry.host_time_ns = procs[i]->m_prof_host_ns;
+        profile.push_back( entry );
+    }
+
+    std::stable_sort( profile.begin(), profile.end(), sc_profile_before );
+#endif
+    return profile;
+}
+
+void
+sc_simcontext::print_process_profile( ::std::ostream& os,
+                                      std::size_t n ) const
+{
+#ifdef SC_ENABLE_PROCESS_PROFILING
+    std::vector<sc_process_profile> profile = process_profile();
+
+    sc_dt::uint64 total = 0;
+    for( std::size_t i = 0; i < profile.size(); ++ i )
+        total += profile[i].host_time_ns;
+
+    if( n > profile.size() )
+        n = profile.size();
+
+    ::std::ios::fmtflags flags = os.flags();
+    ::std::streamsize precision = os.precision();
+
+    os << "top " << n << " of " << profile.size()
+       << " processes by host time:" << ::std::endl;
+    for( std::size_t i = 0; i < n; ++ i ) {
+        const sc_process_profile& p = profile[i];
+        const char* kind = p.kind == SC_METHOD_PROC_ ? "method"
+                         : p.kind == SC_CTHREAD_PROC_ ? "cthread"
+                         : "thread";
+        os << "  " << ::std::setw( 10 ) << p.host_time_ns / 1000 << "us "
+           << ::std::setw( 5 ) << ::std::fixed << ::std::setprecision( 1 )
+           << ( total ? 100.0 * p.host_time_ns / total : 0.0 ) << "% "
+           << ::std::setw( 10 ) << p.activations << "x "
+           << ::std::setw( 7 ) << ::std::left << kind << ::std::right
+           << " " << p.name << ::std::endl;
+    }
+
+    os.flags( flags );
+    os.precision( precision );
+
+    os << "delta cycles: " << m_prof_deltas << " in " << m_prof_timesteps
+       << " timesteps, at most " << m_prof_max_deltas << " at "
+       << m_prof_max_time << ::std::endl;
+#else
+    os << "process profiling disabled, rebuild SystemC with "
+       << "ENABLE_PROCESS_PROFILING" << ::std::endl;
+#endif
+}
+
+void
+sc_simcontext::reset_process_profile()
+{
+#ifdef SC_ENABLE_PROCESS_PROFILING
+    for( sc_method_handle method_p = m_process_table->method_q_head();
+         method_p; method_p = method_p->next_exist() ) {
+        method_p->m_prof_runs = 0;
+        method_p->m_prof_host_ns = 0;
+    }
+    for( sc_thread_handle thread_p = m_process_table->thread_q_head();
+         thread_p; thread_p = thread_p->next_exist() ) {
+        thread_p->m_prof_runs = 0;
+        thread_p->m_prof_host_ns = 0;
+    }
+
+    m_prof_timesteps = 0;
+    m_prof_deltas = 0;
+    m_prof_max_deltas = 0;
+    m_prof_max_time = SC_ZERO_TIME;
+#endif
+}
+
+SC_API bool
+sc_process_profiling_enabled()
+{
+#ifdef SC_ENABLE_PROCESS_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+SC_API std::vector<sc_process_profile>
+sc_get_process_profile()
+{
+    return sc_get_curr_simcontext()->process_profile();
+}
+
+SC_API void
+sc_print_process_profile( ::std::ostream& os, std::size_t top_n )
+{
+    sc_get_curr_simcontext()->print_process_profile( os, top_n );
+}
+
+SC_API void
+sc_reset_process_profile()
+{
+    sc_get_curr_simcontext()->reset_process_profile();
 }
 
 void
@@ -1371,15 +1577,12 @@ sc_simcontext::is_running() const
 bool
 sc_simcontext::next_time( sc_time& result ) const
 {
-    while( m_timed_events->size() ) {
-	sc_event_timed* et = m_timed_events->top();
-	if( et->event() != 0 ) {
-	    result = et->notify_time();
-	    return true;
-	}
-	delete m_timed_events->extract_top();
-    }
-    return false;
+    // cancelled notifications are removed eagerly, so the top of the
+    // queue is always a live event
+    if( m_timed_events->empty() )
+        return false;
+    result = m_timed_events->top()->notify_time();
+    return true;
 }
 
 void
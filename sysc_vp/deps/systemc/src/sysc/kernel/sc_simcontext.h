@@ -59,6 +59,7 @@ class sc_object;
 class sc_object_manager;
 class sc_phase_callback_registry;
 class sc_process_handle;
+struct sc_process_profile;
 class sc_port_registry;
 class sc_prim_channel_registry;
 class sc_process_table;
@@ -293,6 +294,12 @@ public:
     bool next_time( sc_time& t ) const; 
     bool pending_activity_at_current_time() const;
 
+    void print_stack_usage( ::std::ostream& os ) const;
+
+    std::vector<sc_process_profile> process_profile() const;
+    void print_process_profile( ::std::ostream& os, std::size_t n ) const;
+    void reset_process_profile();
+
 private:
 
     void add_child_event( sc_event* );
@@ -304,7 +311,9 @@ private:
 
     int add_delta_event( sc_event* );
     void remove_delta_event( sc_event* );
+
     void add_timed_event( sc_event_timed* );
+    void remove_timed_event( sc_event_timed* );
 
     void trace_cycle( bool delta_cycle );
 
@@ -367,7 +376,19 @@ private:
     std::vector<sc_object*>     m_child_objects;
 
     std::vector<sc_event*>      m_delta_events;
-    sc_ppq<sc_event_timed*>*    m_timed_events;
+    sc_dpq<sc_event_timed>*     m_timed_events;
+    sc_dt::uint64               m_timed_event_order;
+
+#ifdef SC_ENABLE_PROCESS_PROFILING
+    void profile_switch( sc_process_b* next );
+
+    sc_process_b*               m_prof_curr;      // process being timed
+    sc_dt::uint64               m_prof_start_ns;  // host time it started
+    sc_dt::uint64               m_prof_timesteps; // timesteps simulated
+    sc_dt::uint64               m_prof_deltas;    // delta cycles simulated
+    sc_dt::uint64               m_prof_max_deltas;// most deltas in a step
+    sc_time                     m_prof_max_time;  // where that happened
+#endif
 
     std::vector<sc_trace_file*> m_trace_files;
     bool                        m_something_to_trace;
@@ -600,13 +621,6 @@ sc_simcontext::add_delta_event( sc_event* e )
     return static_cast<int>( m_delta_events.size() - 1 );
 }
 
-inline
-void
-sc_simcontext::add_timed_event( sc_event_timed* et )
-{
-    m_timed_events->insert( et );
-}
-
 // ----------------------------------------------------------------------------
 
 inline sc_process_b*
@@ -754,6 +768,28 @@ SC_API sc_time
 sc_time_to_pending_activity
   ( const sc_simcontext* simc_p = sc_get_curr_simcontext() );
 
+// host time profile of a process, see sc_get_process_profile
+struct SC_API sc_process_profile
+{
+    std::string       name;
+    sc_curr_proc_kind kind;
+    sc_dt::uint64     activations;
+    sc_dt::uint64     host_time_ns;
+};
+
+// per-process host time accounting, only available if SystemC was built
+// with ENABLE_PROCESS_PROFILING; processes are sorted by host time
+SC_API bool sc_process_profiling_enabled();
+SC_API std::vector<sc_process_profile> sc_get_process_profile();
+SC_API void sc_print_process_profile( ::std::ostream& os,
+                                      std::size_t top_n = 10 );
+SC_API void sc_reset_process_profile();
+
+// stack size and stack high-water mark of thread processes
+SC_API std::size_t sc_stack_size( const sc_process_handle& );
+SC_API std::size_t sc_stack_usage( const sc_process_handle& );
+SC_API void sc_print_stack_usage( ::std::ostream& os );
+
 
 inline
 bool
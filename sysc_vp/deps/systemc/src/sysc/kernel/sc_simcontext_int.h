@@ -86,6 +86,9 @@ inline
 void
 sc_simcontext::set_curr_proc( sc_process_b* process_h )
 {
+#ifdef SC_ENABLE_PROCESS_PROFILING
+    profile_switch( process_h );
+#endif
     m_curr_proc_info.process_handle = process_h;
     m_curr_proc_info.kind           = process_h->proc_kind();
     m_current_writer =
@@ -96,6 +99,9 @@ inline
 void
 sc_simcontext::reset_curr_proc()
 {
+#ifdef SC_ENABLE_PROCESS_PROFILING
+    profile_switch( 0 );
+#endif
     m_curr_proc_info.process_handle = 0;
     m_curr_proc_info.kind           = SC_NO_PROC_;
     m_current_writer                = 0;
@@ -252,6 +258,9 @@ sc_simcontext::pop_runnable_method()
 	return 0;
     }
     set_curr_proc( (sc_process_b*)method_h );
+#ifdef SC_ENABLE_PROCESS_PROFILING
+    method_h->m_prof_runs++;
+#endif
     return method_h;
 }
 
@@ -265,6 +274,9 @@ sc_simcontext::pop_runnable_thread()
 	return 0;
     }
     set_curr_proc( (sc_process_b*)thread_h );
+#ifdef SC_ENABLE_PROCESS_PROFILING
+    thread_h->m_prof_runs++;
+#endif
     return thread_h;
 }
 
@@ -892,6 +892,29 @@ sc_set_stack_size( sc_thread_handle thread_h, std::size_t size )
     thread_h->set_stack_size( size );
 }
 
+
+//------------------------------------------------------------------------------
+//"sc_stack_size" and "sc_stack_usage"
+//
+// Return the stack size and the number of stack bytes used so far by the
+// given thread process. Both functions return zero for method processes.
+//------------------------------------------------------------------------------
+SC_API std::size_t
+sc_stack_size( const sc_process_handle& handle )
+{
+    sc_thread_handle thread_h =
+        dynamic_cast<sc_thread_handle>( handle.get_process_object() );
+    return thread_h ? thread_h->stack_size() : 0;
+}
+
+SC_API std::size_t
+sc_stack_usage( const sc_process_handle& handle )
+{
+    sc_thread_handle thread_h =
+        dynamic_cast<sc_thread_handle>( handle.get_process_object() );
+    return thread_h ? thread_h->stack_usage() : 0;
+}
+
 #undef DEBUG_MSG
 #undef DEBUG_NAME
 
@@ -96,6 +96,8 @@ SC_API void wait( const sc_time&, const sc_event_and_list&, sc_simcontext* );
 class sc_thread_process : public sc_process_b {
     friend void sc_thread_cor_fn( void* );
     friend void sc_set_stack_size( sc_thread_handle, std::size_t );
+    friend SC_API std::size_t sc_stack_size( const sc_process_handle& );
+    friend SC_API std::size_t sc_stack_usage( const sc_process_handle& );
     friend class sc_event;
     friend class sc_join;
     friend class sc_module;
@@ -142,6 +144,9 @@ class sc_thread_process : public sc_process_b {
     void set_next_runnable( sc_thread_handle next_p );
 
     void set_stack_size( std::size_t size );
+    std::size_t stack_size() const { return m_stack_size; }
+    std::size_t stack_usage() const
+        { return m_cor_p ? m_cor_p->stack_usage() : 0; }
     inline void suspend_me();
     virtual void suspend_process(
         sc_descendant_inclusion_info descendants = SC_NO_DESCENDANTS );
@@ -32,6 +32,14 @@
 
 
 #include "sysc/kernel/sc_cmnhdr.h"
+#include "sysc/utils/sc_report.h"  // sc_assert
+
+#include <vector>
+
+// fan-out of the timed event queue, see sc_dpq below
+#ifndef SC_TIMED_EVENT_QUEUE_ARITY
+#   define SC_TIMED_EVENT_QUEUE_ARITY 2
+#endif
 
 namespace sc_core {
 
@@ -127,6 +135,124 @@ public:
     // size() and empty() are inherited.
 };
 
+
+// ----------------------------------------------------------------------------
+//  CLASS TEMPLATE : sc_dpq<T,D>
+//
+//  Priority queue of T pointers based on a D-ary min-heap. Every element
+//  records its current position in T::m_heap_index, so that it can be
+//  removed from the middle of the queue in O(log n) instead of lingering
+//  until it reaches the top. Ordering is given by the static function
+//  T::heap_before( const T*, const T* ). Larger fan-outs make the tree
+//  shallower at the cost of more comparisons per level.
+// ----------------------------------------------------------------------------
+
+template <class T, int D = SC_TIMED_EVENT_QUEUE_ARITY>
+class sc_dpq
+{
+public:
+
+    sc_dpq( int sz = 128 )
+        : m_heap()
+	{ m_heap.reserve( sz ); }
+
+    T* top() const
+	{ return m_heap.front(); }
+
+    int size() const
+	{ return static_cast<int>( m_heap.size() ); }
+
+    bool empty() const
+	{ return m_heap.empty(); }
+
+    void insert( T* elem )
+    {
+        m_heap.push_back( elem );
+        sift_up( size() - 1, elem );
+    }
+
+    T* extract_top()
+    {
+        T* topelem = m_heap.front();
+        remove_at( 0 );
+        return topelem;
+    }
+
+    void remove( T* elem )
+    {
+        sc_assert( elem->m_heap_index >= 0 && elem->m_heap_index < size() );
+        sc_assert( m_heap[elem->m_heap_index] == elem );
+        remove_at( elem->m_heap_index );
+    }
+
+private:
+
+    void remove_at( int i )
+    {
+        T* elem = m_heap[i];
+        T* last = m_heap.back();
+        m_heap.pop_back();
+        elem->m_heap_index = -1;
+        if( elem == last )
+            return;
+
+        if( i > 0 && T::heap_before( last, m_heap[(i - 1) / D] ) )
+            sift_up( i, last );
+        else
+            sift_down( i, last );
+    }
+
+    void sift_up( int i, T* elem )
+    {
+        while( i > 0 ) {
+            int p = (i - 1) / D;
+            if( !T::heap_before( elem, m_heap[p] ) )
+                break;
+            m_heap[i] = m_heap[p];
+            m_heap[i]->m_heap_index = i;
+            i = p;
+        }
+        m_heap[i] = elem;
+        elem->m_heap_index = i;
+    }
+
+    void sift_down( int i, T* elem )
+    {
+        const int n = size();
+        for( ;; ) {
+            int first = i * D + 1;
+            if( first >= n )
+                break;
+
+            int last = first + D < n ? first + D : n;
+            int best = first;
+            for( int c = first + 1; c < last; ++ c ) {
+                if( T::heap_before( m_heap[c], m_heap[best] ) )
+                    best = c;
+            }
+
+            if( !T::heap_before( m_heap[best], elem ) )
+                break;
+
+            m_heap[i] = m_heap[best];
+            m_heap[i]->m_heap_index = i;
+            i = best;
+        }
+        m_heap[i] = elem;
+        elem->m_heap_index = i;
+    }
+
+private:
+
+    std::vector<T*> m_heap;
+
+private:
+
+    // disabled
+    sc_dpq( const sc_dpq<T,D>& );
+    sc_dpq<T,D>& operator = ( const sc_dpq<T,D>& );
+};
+
 } // namespace sc_core
 
 // $Log: sc_pq.h,v $
@@ -14,8 +14,10 @@
 #include "vcml/core/types.h"
 #include "vcml/core/version.h"
 #include "vcml/core/thctl.h"
+#include "vcml/core/replay.h"
 #include "vcml/core/systemc.h"
 #include "vcml/core/range.h"
+#include "vcml/core/histogram.h"
 #include "vcml/core/peq.h"
 #include "vcml/core/command.h"
 #include "vcml/core/module.h"
@@ -44,6 +46,7 @@
 #include "vcml/properties/broker_lua.h"
 
 #include "vcml/debugging/symtab.h"
+#include "vcml/debugging/profiler.h"
 #include "vcml/debugging/target.h"
 #include "vcml/debugging/loader.h"
 #include "vcml/debugging/subscriber.h"
@@ -34,6 +34,7 @@ private:
     sc_event m_clkrst_ev;
 
     bool cmd_reset(const vector<string>& args, ostream& os);
+    bool cmd_sync_stats(const vector<string>& args, ostream& os);
 
     void do_reset();
 
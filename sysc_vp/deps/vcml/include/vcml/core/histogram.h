@@ -0,0 +1,78 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef VCML_HISTOGRAM_H
+#define VCML_HISTOGRAM_H
+
+#include "vcml/core/types.h"
+
+namespace vcml {
+
+// Log-linear histogram: values below 8 get their own bucket, larger values
+// are grouped by their leading bit and split into 8 linear sub-buckets, so
+// every bucket covers at most 12.5% of its values. Memory use is constant
+// regardless of the number or range of recorded values.
+class histogram
+{
+public:
+    static constexpr size_t SUB_BITS = 3;
+    static constexpr size_t SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr size_t NUM_BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+private:
+    u64 m_count;
+    u64 m_sum;
+    u64 m_min;
+    u64 m_max;
+    u64 m_buckets[NUM_BUCKETS];
+
+public:
+    u64 count() const { return m_count; }
+    u64 sum() const { return m_sum; }
+    u64 min() const { return m_count ? m_min : 0; }
+    u64 max() const { return m_max; }
+    u64 mean() const { return m_count ? m_sum / m_count : 0; }
+
+    u64 bucket(size_t idx) const { return m_buckets[idx]; }
+
+    histogram() { reset(); }
+
+    void reset();
+    void record(u64 val);
+
+    // returns an upper bound for the value below which pct percent of all
+    // recorded values fall, e.g. percentile(99.9) for the p999 value
+    u64 percentile(double pct) const;
+
+    static size_t bucket_of(u64 val);
+    static u64 bucket_lo(size_t idx);
+    static u64 bucket_hi(size_t idx);
+};
+
+inline size_t histogram::bucket_of(u64 val) {
+    if (val < SUB_BUCKETS)
+        return val;
+
+    size_t msb = fls(val);
+    size_t sub = (val >> (msb - SUB_BITS)) & (SUB_BUCKETS - 1);
+    return (msb - SUB_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+inline void histogram::record(u64 val) {
+    m_buckets[bucket_of(val)]++;
+    m_count++;
+    m_sum += val;
+    m_min = std::min(m_min, val);
+    m_max = std::max(m_max, val);
+}
+
+} // namespace vcml
+
+#endif
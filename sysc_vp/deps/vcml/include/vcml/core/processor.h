@@ -13,6 +13,7 @@
 
 #include "vcml/core/types.h"
 #include "vcml/core/range.h"
+#include "vcml/core/histogram.h"
 #include "vcml/core/component.h"
 
 #include "vcml/logging/logger.h"
@@ -23,6 +24,7 @@
 
 #include "vcml/debugging/target.h"
 #include "vcml/debugging/gdbserver.h"
+#include "vcml/debugging/profiler.h"
 
 namespace vcml {
 
@@ -30,9 +32,17 @@ struct irq_stats {
     size_t irq;
     size_t irq_count;
     bool irq_status;
+    bool irq_pending;
     sc_time irq_last;
     sc_time irq_uptime;
     sc_time irq_longest;
+
+    // nanoseconds from assertion to deassertion of the interrupt line
+    histogram irq_duration;
+
+    // nanoseconds from assertion until the processor executes its next
+    // instruction, i.e. an upper bound for the time to enter the handler
+    histogram irq_latency;
 };
 
 class processor : public component, public debugging::target
@@ -44,8 +54,12 @@ private:
     debugging::gdbserver* m_gdb;
 
     unordered_map<size_t, irq_stats> m_irq_stats;
+    size_t m_irq_pending;
     unordered_map<u64, property<void>*> m_regprops;
 
+    debugging::profiler m_profiler;
+    u64 m_next_sample;
+
     bool cmd_dump(const vector<string>& args, ostream& os);
     bool cmd_read(const vector<string>& args, ostream& os);
     bool cmd_symbols(const vector<string>& args, ostream& os);
@@ -54,6 +68,7 @@ private:
     bool cmd_v2p(const vector<string>& args, ostream& os);
     bool cmd_stack(const vector<string>& args, ostream& os);
     bool cmd_gdb(const vector<string>& args, ostream& os);
+    bool cmd_profile(const vector<string>& args, ostream& os);
 
     virtual bool read_cpureg_dbg(const debugging::cpureg& reg, void* buf,
                                  size_t len) override;
@@ -61,8 +76,14 @@ private:
                                   size_t len) override;
 
     void sample_callstack();
+    void sample_profile();
+    void write_profile();
+
+    void record_irq_latency();
+    void write_irq_stats();
 
     u64 simulate_cycles(size_t cycles);
+    sc_time idle_time(const sc_time& fallback);
     void processor_thread();
     bool processor_thread_sync();
     bool processor_thread_async();
@@ -80,6 +101,11 @@ public:
     property<unsigned int> async_rate;
 
     property<bool> trace_callstack;
+    property<string> irq_stats_file;
+
+    property<u64> profile_interval;
+    property<bool> profile_stacks;
+    property<string> profile_file;
 
     gpio_target_array irq;
 
@@ -105,6 +131,8 @@ public:
 
     bool get_irq_stats(size_t irq, irq_stats& stats) const;
 
+    const debugging::profiler& profile() const { return m_profiler; }
+
     template <typename T>
     inline tlm_response_status fetch(u64 addr, T& data);
 
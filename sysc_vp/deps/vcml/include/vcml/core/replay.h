@@ -0,0 +1,92 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef VCML_REPLAY_H
+#define VCML_REPLAY_H
+
+#include "vcml/core/types.h"
+#include "vcml/core/systemc.h"
+
+#include "vcml/logging/logger.h"
+
+namespace vcml {
+
+// Records inputs that enter the simulation from host threads (serial
+// backends, network bridges, etc.) together with the simulation time at which
+// they were consumed, so that a later run can reinject them at exactly those
+// times instead of whenever the host delivers them. Models identify their
+// inputs by a channel name, usually their own hierarchical name. The log is
+// a compact stream of variable-length records:
+//   varint time delta | varint channel | varint size | data[size]
+// Channel zero announces the next channel name in order of first use.
+class replay
+{
+public:
+    typedef function<void(const vector<u8>&)> inject_fn;
+
+private:
+    enum mode {
+        MODE_OFF,
+        MODE_RECORD,
+        MODE_PLAYBACK,
+    };
+
+    mode m_mode;
+    string m_file;
+    ofstream m_output;
+    ifstream m_input;
+    u64 m_last;
+    u64 m_events;
+
+    unordered_map<string, u64> m_ids;
+    vector<string> m_names;
+    unordered_map<string, inject_fn> m_channels;
+
+    void write_varint(u64 val);
+    bool read_varint(u64& val);
+
+    void write_record(u64 chan, const void* data, size_t size);
+    void write_event(const char* channel, const void* data, size_t size);
+    void playback();
+
+    replay();
+
+public:
+    logger log;
+
+    const char* file() const { return m_file.c_str(); }
+    u64 num_events() const { return m_events; }
+
+    bool is_recording() const { return m_mode == MODE_RECORD; }
+    bool is_replaying() const { return m_mode == MODE_PLAYBACK; }
+
+    ~replay();
+
+    void start_recording(const string& file);
+    void start_playback(const string& file);
+    void stop();
+
+    void attach(const string& channel, inject_fn inject);
+    void detach(const string& channel);
+
+    void record(const char* channel, const void* data, size_t size);
+
+    static replay& instance();
+};
+
+inline void replay::record(const char* channel, const void* data,
+                           size_t size) {
+    if (is_recording())
+        write_event(channel, data, size);
+}
+
+} // namespace vcml
+
+#endif
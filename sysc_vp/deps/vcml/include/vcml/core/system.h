@@ -14,6 +14,7 @@
 #include "vcml/core/types.h"
 #include "vcml/core/module.h"
 #include "vcml/core/register.h"
+#include "vcml/core/replay.h"
 
 #include "vcml/debugging/vspserver.h"
 
@@ -24,6 +25,8 @@ class system : public module
 private:
     void timeout();
 
+    bool cmd_sc_profile(const vector<string>& args, ostream& os);
+
 public:
     property<string> name;
     property<string> desc;
@@ -37,6 +40,11 @@ public:
     property<sc_time> quantum;
     property<sc_time> duration;
 
+    property<bool> async_deterministic;
+
+    property<string> input_record;
+    property<string> input_replay;
+
     system() = delete;
     system(const system&) = delete;
     explicit system(const sc_module_name& name);
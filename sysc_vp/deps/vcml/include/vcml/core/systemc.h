@@ -387,6 +387,21 @@ void sc_progress(const sc_time& delta);
 void sc_sync(function<void(void)> job);
 void sc_join_async();
 
+// like sc_sync, but returns without waiting for job to complete; posted jobs
+// and sc_sync jobs run in the order they were issued, typically all at once
+// when the kernel next catches up with the async thread
+void sc_post(function<void(void)> job);
+
+// blocks the calling async thread while it is a full quantum or more ahead
+// of the kernel; all waiting threads are released at quantum boundaries
+void sc_async_wait_quantum(const sc_time& quantum);
+
+// deterministic mode serves sc_sync requests and advances time for async
+// threads in the same order in each run, at the cost of the kernel waiting
+// for each async thread to reach its next request or quantum boundary
+void sc_async_set_deterministic(bool deterministic = true);
+bool sc_async_is_deterministic();
+
 bool sc_is_async();
 
 sc_time async_time_stamp();
@@ -29,6 +29,18 @@ void thctl_flush();
 
 void thctl_set_sysc_thread(thread::id id = std::this_thread::get_id());
 
+// Queues job to run on the SystemC thread during the next update phase.
+// Unlike critical sections, this does not suspend the kernel: jobs posted
+// by any number of threads are collected without locking and run in one
+// batch, in the order they were posted. thctl_post returns immediately,
+// thctl_call blocks until job has completed.
+void thctl_post(function<void(void)> job);
+void thctl_call(function<void(void)> job);
+
+// sleeps while word still holds val, but at most for timeout_us microseconds
+void thctl_futex_wait(atomic<u32>& word, u32 val, u64 timeout_us);
+void thctl_futex_wake(atomic<u32>& word);
+
 class thctl_guard
 {
 private:
@@ -0,0 +1,58 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef VCML_DEBUGGING_PROFILER_H
+#define VCML_DEBUGGING_PROFILER_H
+
+#include "vcml/core/types.h"
+#include "vcml/debugging/symtab.h"
+#include "vcml/debugging/target.h"
+
+namespace vcml {
+namespace debugging {
+
+// Statistical profiler: counts how often each program counter (and optionally
+// each call stack) was observed. Samples are aggregated by address and only
+// resolved into function names using the symbol table when reporting, so
+// taking a sample is cheap. Reports are available as a flat profile and in
+// the folded stack format understood by flamegraph tools.
+class profiler
+{
+private:
+    const symtab& m_symbols;
+    u64 m_samples;
+    unordered_map<u64, u64> m_hits;
+    unordered_map<string, u64> m_stacks;
+
+    string symbol_name(u64 addr) const;
+
+public:
+    u64 samples() const { return m_samples; }
+    u64 hits(u64 addr) const;
+
+    profiler(const symtab& syms);
+    ~profiler() = default;
+
+    profiler(const profiler&) = delete;
+    profiler& operator=(const profiler&) = delete;
+
+    void reset();
+
+    void sample(u64 pc);
+    void sample(const vector<stackframe>& frames);
+
+    void write_flat(ostream& os, size_t limit = ~0ull) const;
+    void write_folded(ostream& os) const;
+};
+
+} // namespace debugging
+} // namespace vcml
+
+#endif
@@ -52,6 +52,8 @@ private:
     mapping m_default;
 
     const mapping& lookup(tlm_target_socket& src, const range& addr) const;
+    size_t lookup_sg(tlm_target_socket& src, const mapping& m,
+                     const tlm_generic_payload& tx, const sgext& sg) const;
     void handle_bus_error(tlm_generic_payload& tx) const;
 
     bool cmd_mmap(const vector<string>& args, ostream& os);
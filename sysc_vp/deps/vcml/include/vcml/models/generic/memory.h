@@ -29,11 +29,15 @@ private:
     tlm_memory m_memory;
 
     bool cmd_show(const vector<string>& args, ostream& os);
+    bool cmd_snapshot(const vector<string>& args, ostream& os);
+    bool cmd_restore(const vector<string>& args, ostream& os);
 
     memory();
     memory(const memory&);
 
 protected:
+    virtual void load_bin(const string& filename, u64 offset) override;
+
     virtual u8* allocate_image(u64 size, u64 offset) override;
     virtual void copy_image(const u8* img, u64 size, u64 offset) override;
 
@@ -45,6 +49,12 @@ public:
     property<string> shared;
     property<vector<string>> images;
     property<u8> poison;
+    property<bool> hugepages;
+    property<bool> hugetlb;
+    property<bool> prefault;
+    property<int> numa_node;
+    property<bool> cow_images;
+    property<bool> dirty_tracking;
 
     tlm_target_socket in;
 
@@ -60,6 +70,10 @@ public:
     VCML_KIND(memory);
     virtual void reset() override;
 
+    virtual unsigned int transport(tlm_generic_payload& tx,
+                                   const tlm_sbi& info,
+                                   address_space as) override;
+
     virtual tlm_response_status read(const range& addr, void* data,
                                      const tlm_sbi& info) override;
     virtual tlm_response_status write(const range& addr, const void* data,
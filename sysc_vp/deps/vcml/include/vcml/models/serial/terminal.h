@@ -50,6 +50,7 @@ private:
     bool cmd_history(const vector<string>& args, ostream& os);
 
     void serial_transmit();
+    void serial_replay(const vector<u8>& data);
 
     virtual void serial_receive(u8 data) override;
 
@@ -12,6 +12,8 @@
 #define VCML_PROTOCOLS_TLM_H
 
 #include "vcml/protocols/tlm_sbi.h"
+#include "vcml/protocols/tlm_sg.h"
+#include "vcml/protocols/tlm_mm.h"
 #include "vcml/protocols/tlm_exmon.h"
 #include "vcml/protocols/tlm_memory.h"
 #include "vcml/protocols/tlm_dmi_cache.h"
@@ -16,6 +16,7 @@
 #include "vcml/core/range.h"
 
 #include "vcml/protocols/tlm_sbi.h"
+#include "vcml/protocols/tlm_sg.h"
 #include "vcml/protocols/tlm_dmi_cache.h"
 
 namespace vcml {
@@ -25,15 +26,30 @@ struct exlock {
     range addr;
 };
 
+// Locks are additionally indexed by 64 byte granules, so that checking a
+// transaction against all locks only takes a few hash lookups instead of a
+// scan over all locks. Most transactions do not touch any locked granule.
+// Locks spanning more than MAX_GRANULES are not indexed and always scanned.
 class tlm_exmon
 {
 private:
     vector<exlock> m_locks;
+    unordered_map<u64, size_t> m_index;
+    size_t m_unindexed;
+
+    static constexpr u64 GRANULE_BITS = 6;
+    static constexpr u64 MAX_GRANULES = 64;
+
+    void index(const range& r);
+    void unindex(const range& r);
+
+    bool overlaps(const range& r) const;
+    bool is_indexed(const range& r) const;
 
 public:
     const vector<exlock> get_locks() const { return m_locks; }
 
-    tlm_exmon() = default;
+    tlm_exmon(): m_locks(), m_index(), m_unindexed(0) {}
     virtual ~tlm_exmon() = default;
 
     bool has_lock(int cpu, const range& r) const;
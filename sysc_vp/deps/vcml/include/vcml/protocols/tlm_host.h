@@ -23,6 +23,52 @@ namespace vcml {
 class tlm_initiator_socket;
 class tlm_target_socket;
 
+enum tlm_sync_reason {
+    TLM_SYNC_EXPLICIT = 0, // requested by the model itself
+    TLM_SYNC_QUANTUM,      // local time reached the global quantum
+    TLM_SYNC_TRANSACTION,  // transaction marked as synchronizing
+    TLM_SYNC_REGISTER,     // register configured to sync on access
+    TLM_SYNC_OVERSHOOT,    // target noticed local time overshooting
+    NUM_TLM_SYNC_REASONS,
+};
+
+const char* tlm_sync_reason_str(tlm_sync_reason reason);
+
+struct tlm_sync_stats {
+    u64 num_checks;
+    u64 syncs[NUM_TLM_SYNC_REASONS];
+
+    // local time offsets that were synced, per reason
+    sc_time offsets[NUM_TLM_SYNC_REASONS];
+
+    // amount by which local time exceeded the quantum when syncing
+    u64 num_overshoots;
+    sc_time total_overshoot;
+    sc_time max_overshoot;
+
+    tlm_sync_stats() { reset(); }
+    void reset();
+
+    u64 num_syncs() const;
+    u64 num_forced_syncs() const;
+    sc_time mean_forced_offset() const;
+    sc_time mean_overshoot() const;
+
+    void count(tlm_sync_reason reason, const sc_time& offset,
+               const sc_time& quantum);
+    void merge(const tlm_sync_stats& other);
+
+    // Suggests a quantum for the observed traffic: if mostly the quantum
+    // forced syncs, more decoupling would reduce their number, so suggest
+    // twice the quantum. If mostly transactions forced syncs before the
+    // quantum expired, a larger quantum does not help, but the smallest
+    // quantum that rarely expires first reduces the skew between
+    // initiators at no extra cost, so suggest twice the mean run-ahead.
+    sc_time suggest_quantum(const sc_time& quantum) const;
+
+    void print(ostream& os, const sc_time& quantum) const;
+};
+
 class tlm_host
 {
 private:
@@ -34,6 +80,7 @@ private:
     };
 
     mutable std::unordered_map<sc_process_b*, proc_data> m_processes;
+    tlm_sync_stats m_sync_stats;
     vector<tlm_initiator_socket*> m_initiator_sockets;
     vector<tlm_target_socket*> m_target_sockets;
 
@@ -79,6 +126,10 @@ public:
 
     bool needs_sync(sc_process_b* proc = current_process());
     void sync(sc_process_b* proc = current_process());
+    void sync(tlm_sync_reason reason, sc_process_b* proc = current_process());
+
+    const tlm_sync_stats& sync_stats() const { return m_sync_stats; }
+    void reset_sync_stats() { m_sync_stats.reset(); }
 
     void map_dmi(const tlm_dmi& dmi);
     void map_dmi(unsigned char* ptr, u64 start, u64 end, vcml_access a,
@@ -16,6 +16,7 @@
 #include "vcml/core/systemc.h"
 
 #include "vcml/protocols/tlm_sbi.h"
+#include "vcml/protocols/tlm_sg.h"
 #include "vcml/protocols/tlm_dmi_cache.h"
 
 namespace vcml {
@@ -27,9 +28,22 @@ private:
     void* m_base;
     size_t m_size;
     bool m_discard;
+    bool m_hugepages;
+    bool m_hugetlb;
+    bool m_prefault;
+    int m_numa_node;
+    size_t m_page_size;
+    bool m_tracking;
+    vector<u64> m_dirty;
     string m_shared;
 
     int init_shared(const string& shared, size_t size);
+    void init_pages(u8* ptr, size_t size);
+
+    tlm_response_status check(const range& addr, tlm_command cmd,
+                              bool debug) const;
+    unsigned int transport_sg(tlm_generic_payload& tx, sgext& sg,
+                              bool debug);
 
 public:
     u8* data() const { return get_dmi_ptr(); }
@@ -43,6 +57,17 @@ public:
 
     void discard_writes(bool discard = true) { m_discard = discard; }
 
+    // the following need to be configured before the memory is initialized
+    void use_hugepages(bool use = true) { m_hugepages = use; }
+    void use_hugetlb(bool use = true) { m_hugetlb = use; }
+    void prefault(bool prefault = true) { m_prefault = prefault; }
+    void bind_numa_node(int node) { m_numa_node = node; }
+
+    size_t page_size() const { return m_page_size; }
+    bool is_hugepages() const { return m_hugepages; }
+    bool is_hugetlb() const { return m_page_size > mwr::get_page_size(); }
+    int numa_node() const { return m_numa_node; }
+
     tlm_memory();
     tlm_memory(size_t size);
     tlm_memory(size_t size, alignment al);
@@ -57,6 +82,27 @@ public:
     void free();
     void fill(u8 data);
 
+    bool map_file(const string& filename, u64 offset);
+
+    // Dirty page tracking write protects all pages at every checkpoint and
+    // records the first write to each page, including writes through DMI
+    // pointers. Checkpoints and snapshots must not be taken while other
+    // threads write to the memory. Host system calls cannot write to
+    // protected pages, so mark_dirty must be called before passing a pointer
+    // into the memory to e.g. read(2).
+    bool track_dirty(bool track = true);
+    bool is_tracking_dirty() const { return m_tracking; }
+    bool is_dirty(u64 addr) const;
+    size_t count_dirty() const;
+    size_t count_pages() const;
+    void mark_dirty(const range& addr);
+    void checkpoint();
+
+    // snapshots contain all pages dirtied since the last checkpoint or, if
+    // full is set, the entire memory; saving a snapshot is a checkpoint
+    size_t save_snapshot(ostream& os, bool full = false);
+    bool load_snapshot(istream& is);
+
     tlm_response_status fill(u8 data, bool debug);
 
     tlm_response_status read(const range& addr, void* dest,
@@ -71,7 +117,7 @@ public:
     template <typename T>
     tlm_response_status write(u64 addr, const T& data, bool debug = false);
 
-    void transport(tlm_generic_payload& tx, const tlm_sbi& sbi);
+    unsigned int transport(tlm_generic_payload& tx, const tlm_sbi& sbi);
 
     u8 operator[](size_t offset) const;
     u8& operator[](size_t offset);
@@ -82,6 +128,7 @@ inline void tlm_memory::init(size_t size, alignment al) {
 }
 
 inline void tlm_memory::fill(u8 val) {
+    mark_dirty({ 0, size() - 1 });
     memset(data(), val, size());
 }
 
@@ -0,0 +1,62 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef VCML_PROTOCOLS_TLM_MM_H
+#define VCML_PROTOCOLS_TLM_MM_H
+
+#include "vcml/core/types.h"
+#include "vcml/core/systemc.h"
+
+#include "vcml/protocols/tlm_sbi.h"
+
+namespace vcml {
+
+// Payload pool: hands out recycled payloads that already carry an sbiext,
+// so initiators do not need to construct payloads and extensions for each
+// transaction. Payloads return to the pool once their reference count drops
+// to zero. The pool is not thread-safe and should be owned by one initiator.
+class tlm_mm : public tlm::tlm_mm_interface
+{
+private:
+    vector<tlm_generic_payload*> m_payloads;
+    vector<tlm_generic_payload*> m_free;
+
+public:
+    size_t size() const { return m_payloads.size(); }
+    size_t available() const { return m_free.size(); }
+
+    tlm_mm();
+    virtual ~tlm_mm();
+
+    tlm_mm(const tlm_mm&) = delete;
+    tlm_mm& operator=(const tlm_mm&) = delete;
+
+    tlm_generic_payload* allocate();
+    virtual void free(tlm_generic_payload* tx) override;
+};
+
+inline tlm_generic_payload* tlm_mm::allocate() {
+    tlm_generic_payload* tx;
+    if (m_free.empty()) {
+        tx = new tlm_generic_payload(this);
+        tx->set_extension(new sbiext());
+        m_payloads.push_back(tx);
+    } else {
+        tx = m_free.back();
+        m_free.pop_back();
+    }
+
+    tx->acquire();
+    return tx;
+}
+
+} // namespace vcml
+
+#endif
@@ -25,10 +25,60 @@
 
 namespace vcml {
 
+struct tlm_probe_stats {
+    // size classes are powers of two: 1, 2, 4, ..., 64 and >64 bytes
+    static constexpr size_t NUM_SIZES = 8;
+
+    // delay buckets: 0, then [2^(i-1), 2^i) nanoseconds, last is open-ended
+    static constexpr size_t NUM_DELAYS = 24;
+
+    u64 reads[NUM_SIZES];
+    u64 writes[NUM_SIZES];
+    u64 ignores;
+
+    u64 num_b_transport;
+    u64 num_nb_transport;
+    u64 num_transport_dbg;
+
+    u64 num_dmi_requests;
+    u64 num_dmi_granted;
+    u64 num_dmi_invalidations;
+
+    u64 num_errors;
+    u64 errors[7]; // indexed by 1 - tlm_response_status
+
+    u64 delays[NUM_DELAYS];
+    sc_time total_delay;
+    sc_time max_delay;
+
+    // host time spent in downstream b_transport, including time other
+    // SystemC processes run while the downstream target calls wait
+    u64 host_time_ns;
+
+    tlm_probe_stats() { reset(); }
+    void reset();
+
+    u64 num_reads() const;
+    u64 num_writes() const;
+
+    void count(const tlm_generic_payload& tx);
+    void count_delay(const sc_time& delay);
+
+    static size_t size_class(unsigned int size);
+    static const char* size_class_str(size_t cls);
+    static size_t delay_class(const sc_time& delay);
+};
+
 class tlm_probe : public module,
                   protected tlm::tlm_fw_transport_if<>,
                   protected tlm::tlm_bw_transport_if<>
 {
+private:
+    tlm_probe_stats m_stats;
+
+    bool cmd_stats(const vector<string>& args, ostream& os);
+    bool cmd_reset_stats(const vector<string>& args, ostream& os);
+
 protected:
     virtual void b_transport(tlm_generic_payload& tx, sc_time& dt) override;
     virtual unsigned int transport_dbg(tlm_generic_payload& tx) override;
@@ -42,10 +92,21 @@ protected:
                                                tlm::tlm_phase& phase,
                                                sc_time& t) override;
 
+    virtual void end_of_simulation() override;
+
 public:
+    property<string> stats_file;
+
     tlm_base_target_socket in;
     tlm_base_initiator_socket out;
 
+    const tlm_probe_stats& stats() const { return m_stats; }
+    void reset_stats() { m_stats.reset(); }
+
+    void print_stats(ostream& os) const;
+    void write_csv(ostream& os) const;
+    void write_json(ostream& os) const;
+
     tlm_probe(const sc_module_name& nm);
     virtual ~tlm_probe() = default;
     VCML_KIND(tlm_probe);
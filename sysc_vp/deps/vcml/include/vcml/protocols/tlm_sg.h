@@ -0,0 +1,73 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#ifndef VCML_PROTOCOLS_TLM_SG_H
+#define VCML_PROTOCOLS_TLM_SG_H
+
+#include "vcml/core/types.h"
+#include "vcml/core/systemc.h"
+#include "vcml/core/range.h"
+
+namespace vcml {
+
+struct tlm_sg_segment {
+    u64 addr;
+    u8* data;
+    unsigned int size;
+
+    range get_range() const { return { addr, addr + size - 1 }; }
+};
+
+// Scatter-gather extension: holds additional segments that should be
+// transferred together with the payload. Segment addresses are given in the
+// address space of the initiator; targets relocate them using the payload
+// address they observe relative to the initiator address stored in 'base'.
+// Interconnects may lower 'limit' to the number of segments that are routed
+// to the same target. Targets report the number of segments they have
+// completed, all remaining segments must be sent separately by the initiator.
+class sgext : public tlm_extension<sgext>
+{
+public:
+    u64 base;
+    size_t limit;
+    size_t completed;
+    vector<tlm_sg_segment> segments;
+
+    sgext(): base(), limit(), completed(), segments() {}
+    sgext(u64 addr, const vector<tlm_sg_segment>& segs):
+        base(addr), limit(segs.size()), completed(), segments(segs) {}
+
+    size_t count() const { return min(limit, segments.size()); }
+    u64 local_address(const tlm_generic_payload& tx, size_t i) const;
+    range local_range(const tlm_generic_payload& tx, size_t i) const;
+
+    virtual tlm_extension_base* clone() const override;
+    virtual void copy_from(const tlm_extension_base& ext) override;
+};
+
+inline u64 sgext::local_address(const tlm_generic_payload& tx,
+                                size_t i) const {
+    return segments[i].addr - base + tx.get_address();
+}
+
+inline range sgext::local_range(const tlm_generic_payload& tx,
+                                size_t i) const {
+    u64 addr = local_address(tx, i);
+    return { addr, addr + segments[i].size - 1 };
+}
+
+inline bool tx_has_sg(const tlm_generic_payload& tx) {
+    const sgext* ext = tx.get_extension<sgext>();
+    return ext != nullptr && ext->count() > 0;
+}
+
+} // namespace vcml
+
+#endif
@@ -19,6 +19,8 @@
 
 #include "vcml/protocols/base.h"
 #include "vcml/protocols/tlm_sbi.h"
+#include "vcml/protocols/tlm_sg.h"
+#include "vcml/protocols/tlm_mm.h"
 #include "vcml/protocols/tlm_exmon.h"
 #include "vcml/protocols/tlm_stubs.h"
 #include "vcml/protocols/tlm_adapters.h"
@@ -36,8 +38,7 @@ class tlm_initiator_socket
       public hierarchy_element
 {
 private:
-    tlm_generic_payload m_tx;
-    tlm_generic_payload m_txd;
+    tlm_mm m_mm;
     tlm_sbi m_sbi;
     tlm_dmi_cache* m_dmi_cache;
     tlm_target_stub* m_stub;
@@ -76,6 +77,9 @@ public:
 
     tlm_dmi_cache& dmi_cache();
 
+    // returns a recycled payload, call release() on it when done
+    tlm_generic_payload* alloc_payload() { return m_mm.allocate(); }
+
     void map_dmi(const tlm_dmi& dmi);
     void unmap_dmi(u64 start, u64 end);
 
@@ -92,6 +96,10 @@ public:
                                const tlm_sbi& info = SBI_NONE,
                                unsigned int* nbytes = nullptr);
 
+    tlm_response_status access_sg(tlm_command cmd,
+                                  const vector<tlm_sg_segment>& segments,
+                                  const tlm_sbi& info = SBI_NONE);
+
     tlm_response_status read(u64 addr, void* data, unsigned int size,
                              const tlm_sbi& info = SBI_NONE,
                              unsigned int* nbytes = nullptr);
@@ -18,6 +18,11 @@ bool component::cmd_reset(const vector<string>& args, ostream& os) {
     return true;
 }
 
+bool component::cmd_sync_stats(const vector<string>& args, ostream& os) {
+    sync_stats().print(os, tlm::tlm_global_quantum::instance().get());
+    return true;
+}
+
 void component::do_reset() {
     for (auto socket : get_tlm_target_sockets())
         socket->invalidate_dmi();
@@ -35,6 +40,8 @@ component::component(const sc_module_name& nm, bool dmi, unsigned int bus):
     rst("rst") {
     register_command("reset", 0, &component::cmd_reset,
                      "resets this component");
+    register_command("sync_stats", 0, &component::cmd_sync_stats,
+                     "reports how often and why this component synced");
 }
 
 component::~component() {
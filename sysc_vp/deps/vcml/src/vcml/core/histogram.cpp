@@ -0,0 +1,57 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <cmath>
+
+#include "vcml/core/histogram.h"
+
+namespace vcml {
+
+void histogram::reset() {
+    m_count = 0;
+    m_sum = 0;
+    m_min = ~0ull;
+    m_max = 0;
+    memset(m_buckets, 0, sizeof(m_buckets));
+}
+
+u64 histogram::percentile(double pct) const {
+    if (m_count == 0)
+        return 0;
+
+    u64 rank = (u64)std::ceil(m_count * std::clamp(pct, 0.0, 100.0) / 100.0);
+    rank = std::max<u64>(rank, 1);
+
+    u64 seen = 0;
+    for (size_t idx = 0; idx < NUM_BUCKETS; idx++) {
+        seen += m_buckets[idx];
+        if (seen >= rank)
+            return std::min(bucket_hi(idx), m_max);
+    }
+
+    return m_max;
+}
+
+u64 histogram::bucket_lo(size_t idx) {
+    if (idx < SUB_BUCKETS)
+        return idx;
+
+    size_t msb = idx / SUB_BUCKETS + SUB_BITS - 1;
+    u64 sub = idx % SUB_BUCKETS;
+    return (SUB_BUCKETS + sub) << (msb - SUB_BITS);
+}
+
+u64 histogram::bucket_hi(size_t idx) {
+    if (idx + 1 >= NUM_BUCKETS)
+        return ~0ull;
+    return bucket_lo(idx + 1) - 1;
+}
+
+} // namespace vcml
@@ -173,7 +173,7 @@ unsigned int peripheral::transport(tlm_generic_payload& tx,
 
     // check for quantum overshoot
     if (!info.is_debug && needs_sync())
-        sync();
+        sync(TLM_SYNC_OVERSHOOT);
 
     return nbytes;
 }
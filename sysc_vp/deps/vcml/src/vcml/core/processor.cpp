@@ -19,6 +19,12 @@
 
 namespace vcml {
 
+static void print_percentiles(ostream& os, const histogram& h) {
+    os << "p50 " << h.percentile(50.0) / 1e3 << "us\\, "
+       << "p99 " << h.percentile(99.0) / 1e3 << "us\\, "
+       << "p999 " << h.percentile(99.9) / 1e3 << "us";
+}
+
 bool processor::cmd_dump(const vector<string>& args, ostream& os) {
     os << "Registers:" << std::endl
        << "  PC 0x" << HEX(program_counter(), 16) << std::endl
@@ -42,7 +48,15 @@ bool processor::cmd_dump(const vector<string>& args, ostream& os) {
 
             os << stats.irq_count << " events, "
                << "avg " << avg * 1e6 << "us\\, "
-               << "max " << max * 1e6 << "us" << std::endl;
+               << "max " << max * 1e6 << "us\\, ";
+            print_percentiles(os, stats.irq_duration);
+            os << std::endl;
+
+            if (stats.irq_latency.count() > 0) {
+                os << "    latency ";
+                print_percentiles(os, stats.irq_latency);
+                os << std::endl;
+            }
         }
     }
 
@@ -241,6 +255,98 @@ bool processor::cmd_gdb(const vector<string>& args, ostream& os) {
     return true;
 }
 
+bool processor::cmd_profile(const vector<string>& args, ostream& os) {
+    if (profile_interval == 0u) {
+        os << "profiling disabled, set " << profile_interval.name()
+           << " to enable";
+        return false;
+    }
+
+    size_t limit = 20;
+    if (!args.empty())
+        limit = strtoull(args[0].c_str(), NULL, 0);
+
+    m_profiler.write_flat(os, limit);
+    return true;
+}
+
+void processor::sample_profile() {
+    if (profile_stacks) {
+        vector<debugging::stackframe> frames;
+        stacktrace(frames);
+        m_profiler.sample(frames);
+    } else {
+        m_profiler.sample(program_counter());
+    }
+
+    m_next_sample = cycle_count() + profile_interval;
+}
+
+void processor::write_profile() {
+    string filename = profile_file;
+    if (filename.empty())
+        filename = mkstr("%s.prof", name());
+
+    ofstream flat(filename.c_str(), std::ios::trunc);
+    if (!flat.is_open()) {
+        log_warn("cannot open profile file '%s'", filename.c_str());
+        return;
+    }
+
+    m_profiler.write_flat(flat);
+
+    filename += ".folded";
+    ofstream folded(filename.c_str(), std::ios::trunc);
+    if (!folded.is_open()) {
+        log_warn("cannot open profile file '%s'", filename.c_str());
+        return;
+    }
+
+    m_profiler.write_folded(folded);
+    log_debug("wrote %llu profile samples", m_profiler.samples());
+}
+
+void processor::record_irq_latency() {
+    sc_time now = local_time_stamp();
+    for (auto& it : m_irq_stats) {
+        irq_stats& stats = it.second;
+        if (stats.irq_pending) {
+            sc_time delta = now > stats.irq_last ? now - stats.irq_last
+                                                 : SC_ZERO_TIME;
+            stats.irq_latency.record(time_to_ns(delta));
+            stats.irq_pending = false;
+        }
+    }
+
+    m_irq_pending = 0;
+}
+
+void processor::write_irq_stats() {
+    const string& filename = irq_stats_file;
+    ofstream file(filename.c_str(), std::ios::trunc);
+    if (!file.is_open()) {
+        log_warn("cannot open irq statistics file '%s'", filename.c_str());
+        return;
+    }
+
+    file << "irq,count,avg_ns,max_ns,p50_ns,p99_ns,p999_ns,"
+         << "latency_p50_ns,latency_p99_ns,latency_p999_ns" << std::endl;
+
+    for (auto it : irq) {
+        irq_stats stats;
+        if (!get_irq_stats(it.first, stats))
+            continue;
+
+        const histogram& dur = stats.irq_duration;
+        const histogram& lat = stats.irq_latency;
+        file << it.first << "," << stats.irq_count << "," << dur.mean()
+             << "," << dur.max() << "," << dur.percentile(50.0) << ","
+             << dur.percentile(99.0) << "," << dur.percentile(99.9) << ","
+             << lat.percentile(50.0) << "," << lat.percentile(99.0) << ","
+             << lat.percentile(99.9) << std::endl;
+    }
+}
+
 void processor::sample_callstack() {
 #if defined(HAVE_INSCIGHT) && defined(INSCIGHT_CPU_CALL_STACK)
     if (!trace_callstack)
@@ -263,7 +369,18 @@ u64 processor::simulate_cycles(size_t cycles) {
     if (trace_callstack)
         sample_callstack();
 
+    if (m_irq_pending > 0)
+        record_irq_latency();
+
+    // stop at the next sampling point so that sampling cost stays bounded
+    // by one sample per profile_interval cycles
     u64 count = cycle_count();
+    if (profile_interval > 0u) {
+        if (count >= m_next_sample)
+            sample_profile();
+        cycles = min<u64>(cycles, m_next_sample - count);
+    }
+
     double start = mwr::timestamp();
     set_suspendable(false);
     simulate(cycles);
@@ -272,6 +389,21 @@ u64 processor::simulate_cycles(size_t cycles) {
     return cycle_count() - count;
 }
 
+// Nothing can wake an idle processor before the kernel has something else to
+// do, so it may skip ahead to the next pending activity instead of polling.
+// Falls back to the regular wait time if the kernel has no further activity.
+sc_time processor::idle_time(const sc_time& fallback) {
+    sc_time next = sc_core::sc_time_to_pending_activity();
+    if (next >= sc_core::sc_max_time() - sc_time_stamp())
+        return fallback;
+
+    const sc_time& lt = local_time();
+    if (next <= lt + fallback)
+        return fallback;
+
+    return next - lt;
+}
+
 void processor::processor_thread() {
     wait(SC_ZERO_TIME);
 
@@ -331,8 +463,7 @@ bool processor::processor_thread_async() {
             lt = SC_ZERO_TIME;
         }
 
-        while (sim_running() && async_time_offset() >= quantum)
-            mwr::cpu_yield();
+        sc_async_wait_quantum(quantum);
     }
 }
 
@@ -362,12 +493,12 @@ bool processor::processor_thread_sync() {
             if (is_stepping() && num_cycles > 0)
                 notify_singlestep();
             if (num_cycles == 0)
-                wait(quantum - local_time());
+                wait(idle_time(quantum - local_time()));
         } else
-            wait(num_cycles * clock_cycle());
+            wait(idle_time(num_cycles * clock_cycle()));
     } while (!needs_sync());
 
-    sync();
+    sync(TLM_SYNC_QUANTUM);
 
     return true;
 }
@@ -379,7 +510,10 @@ processor::processor(const sc_module_name& nm, const string& cpuarch):
     m_cycle_count(0),
     m_gdb(nullptr),
     m_irq_stats(),
+    m_irq_pending(0),
     m_regprops(),
+    m_profiler(target::symbols()),
+    m_next_sample(0),
     cpuarch("arch", cpuarch),
     symbols("symbols"),
     gdb_wait("gdb_wait", false),
@@ -389,6 +523,10 @@ processor::processor(const sc_module_name& nm, const string& cpuarch):
     async("async", false),
     async_rate("async_rate", 5),
     trace_callstack("trace_callstack", false),
+    irq_stats_file("irq_stats_file", ""),
+    profile_interval("profile_interval", 0),
+    profile_stacks("profile_stacks", false),
+    profile_file("profile_file", ""),
     irq("irq"),
     insn("insn"),
     data("data") {
@@ -425,6 +563,8 @@ processor::processor(const sc_module_name& nm, const string& cpuarch):
                      "generates a stack trace for the current function");
     register_command("gdb", 0, &processor::cmd_gdb,
                      "opens a new gdb debug session");
+    register_command("profile", 0, &processor::cmd_profile,
+                     "show the most frequently sampled functions");
 }
 
 processor::~processor() {
@@ -506,11 +646,16 @@ void processor::gpio_notify(const gpio_target_socket& socket, bool state,
     if (state) {
         stats.irq_count++;
         stats.irq_last = sc_time_stamp();
+        if (!stats.irq_pending) {
+            stats.irq_pending = true;
+            m_irq_pending++;
+        }
     } else {
         sc_time delta = sc_time_stamp() - stats.irq_last;
         if (delta > stats.irq_longest)
             stats.irq_longest = delta;
         stats.irq_uptime += delta;
+        stats.irq_duration.record(time_to_ns(delta));
     }
 
     log_debug("%sing IRQ %zu", state ? "sett" : "clear", irqno);
@@ -547,11 +692,16 @@ void processor::end_of_elaboration() {
         stats.irq = it.first;
         stats.irq_count = 0;
         stats.irq_status = false;
+        stats.irq_pending = false;
         stats.irq_last = SC_ZERO_TIME;
         stats.irq_uptime = SC_ZERO_TIME;
         stats.irq_longest = SC_ZERO_TIME;
+        stats.irq_duration.reset();
+        stats.irq_latency.reset();
     }
 
+    m_irq_pending = 0;
+
     if (gdb_port >= 0) {
         auto run = gdb_wait ? debugging::GDB_STOPPED : debugging::GDB_RUNNING;
         m_gdb = new debugging::gdbserver(gdb_port, *this, run);
@@ -569,6 +719,12 @@ void processor::end_of_simulation() {
     if (async)
         sc_join_async();
 
+    if (m_profiler.samples() > 0)
+        write_profile();
+
+    if (!irq_stats_file.get().empty())
+        write_irq_stats();
+
     component::end_of_simulation();
 }
 
@@ -117,9 +117,9 @@ unsigned int reg_base::receive(tlm_generic_payload& tx, const tlm_sbi& info) {
 
     if (!info.is_debug) {
         if (tx.is_read() && m_rsync)
-            m_host->sync();
+            m_host->sync(TLM_SYNC_REGISTER);
         if (tx.is_write() && m_wsync)
-            m_host->sync();
+            m_host->sync(TLM_SYNC_REGISTER);
     }
 
     m_host->trace_fw(*this, tx, m_host->local_time());
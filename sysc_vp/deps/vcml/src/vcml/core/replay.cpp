@@ -0,0 +1,202 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "vcml/core/replay.h"
+
+namespace vcml {
+
+struct replay_header {
+    u32 magic;
+    u32 version;
+    u64 resolution;
+};
+
+static const u32 REPLAY_MAGIC = fourcc("vrpl");
+static const u32 REPLAY_VERSION = 1;
+
+static u64 replay_resolution() {
+    return sc_time(1.0, SC_SEC).value();
+}
+
+void replay::write_varint(u64 val) {
+    u8 buf[10];
+    size_t len = 0;
+    do {
+        buf[len] = val & 0x7f;
+        val >>= 7;
+        if (val)
+            buf[len] |= 0x80;
+        len++;
+    } while (val);
+
+    m_output.write((const char*)buf, len);
+}
+
+bool replay::read_varint(u64& val) {
+    val = 0;
+    for (unsigned int shift = 0; shift < 64; shift += 7) {
+        int c = m_input.get();
+        if (c == EOF)
+            return false;
+
+        val |= (u64)(c & 0x7f) << shift;
+        if (!(c & 0x80))
+            return true;
+    }
+
+    return false;
+}
+
+void replay::write_record(u64 chan, const void* data, size_t size) {
+    u64 now = sc_time_stamp().value();
+    write_varint(now - m_last);
+    write_varint(chan);
+    write_varint(size);
+    m_output.write((const char*)data, size);
+    m_last = now;
+}
+
+void replay::playback() {
+    u64 now = 0, delta = 0, chan = 0, size = 0;
+    vector<u8> data;
+
+    while (read_varint(delta) && read_varint(chan) && read_varint(size)) {
+        data.resize(size);
+        if (!m_input.read((char*)data.data(), size))
+            break;
+
+        now += delta;
+        if (chan == 0) {
+            m_names.emplace_back(data.begin(), data.end());
+            continue;
+        }
+
+        if (chan > m_names.size()) {
+            log_warn("invalid channel %llu in %s", chan, m_file.c_str());
+            break;
+        }
+
+        sc_time t = time_from_value(now);
+        if (t > sc_time_stamp())
+            sc_core::wait(t - sc_time_stamp());
+
+        const string& name = m_names[chan - 1];
+        auto it = m_channels.find(name);
+        if (it == m_channels.end()) {
+            log_warn("dropping input for unknown channel %s", name.c_str());
+            continue;
+        }
+
+        it->second(data);
+        m_events++;
+    }
+
+    log_debug("replayed %llu events from %s", m_events, m_file.c_str());
+}
+
+replay::replay():
+    m_mode(MODE_OFF),
+    m_file(),
+    m_output(),
+    m_input(),
+    m_last(0),
+    m_events(0),
+    m_ids(),
+    m_names(),
+    m_channels(),
+    log("replay") {
+    // nothing to do
+}
+
+replay::~replay() {
+    stop();
+}
+
+void replay::start_recording(const string& file) {
+    VCML_ERROR_ON(m_mode != MODE_OFF, "replay already active");
+
+    m_output.open(file.c_str(), std::ios::binary | std::ios::trunc);
+    VCML_ERROR_ON(!m_output.good(), "cannot open replay file %s",
+                  file.c_str());
+
+    replay_header header;
+    header.magic = REPLAY_MAGIC;
+    header.version = REPLAY_VERSION;
+    header.resolution = replay_resolution();
+    m_output.write((const char*)&header, sizeof(header));
+
+    m_mode = MODE_RECORD;
+    m_file = file;
+    m_last = 0;
+    m_events = 0;
+    m_ids.clear();
+}
+
+void replay::start_playback(const string& file) {
+    VCML_ERROR_ON(m_mode != MODE_OFF, "replay already active");
+
+    m_input.open(file.c_str(), std::ios::binary);
+    VCML_ERROR_ON(!m_input.good(), "cannot open replay file %s",
+                  file.c_str());
+
+    replay_header header;
+    if (!m_input.read((char*)&header, sizeof(header)) ||
+        header.magic != REPLAY_MAGIC || header.version != REPLAY_VERSION) {
+        VCML_ERROR("invalid replay file %s", file.c_str());
+    }
+
+    if (header.resolution != replay_resolution())
+        VCML_ERROR("time resolution mismatch in replay file %s", file.c_str());
+
+    m_mode = MODE_PLAYBACK;
+    m_file = file;
+    m_events = 0;
+    m_names.clear();
+
+    sc_spawn([&]() -> void { playback(); }, "$$$$vcml_replay$$$$");
+}
+
+void replay::stop() {
+    if (is_recording())
+        m_output.close();
+    if (is_replaying())
+        m_input.close();
+
+    m_mode = MODE_OFF;
+}
+
+void replay::attach(const string& channel, inject_fn inject) {
+    VCML_ERROR_ON(stl_contains(m_channels, channel),
+                  "replay channel %s already attached", channel.c_str());
+    m_channels[channel] = std::move(inject);
+}
+
+void replay::detach(const string& channel) {
+    m_channels.erase(channel);
+}
+
+void replay::write_event(const char* channel, const void* data,
+                         size_t size) {
+    auto it = m_ids.find(channel);
+    if (it == m_ids.end()) {
+        write_record(0, channel, strlen(channel));
+        it = m_ids.insert({ channel, m_ids.size() + 1 }).first;
+    }
+
+    write_record(it->second, data, size);
+    m_events++;
+}
+
+replay& replay::instance() {
+    static replay singleton;
+    return singleton;
+}
+
+} // namespace vcml
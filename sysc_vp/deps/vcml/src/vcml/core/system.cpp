@@ -64,6 +64,12 @@ void system::timeout() {
     }
 }
 
+bool system::cmd_sc_profile(const vector<string>& args, ostream& os) {
+    size_t n = args.empty() ? 10 : from_string<size_t>(args[0]);
+    sc_core::sc_print_process_profile(os, n);
+    return true;
+}
+
 system::system(const sc_module_name& nm):
     module(nm),
     name("name", mwr::progname()),
@@ -73,13 +79,29 @@ system::system(const sc_module_name& nm):
     session("session", -1),
     session_debug("session_debug", false),
     quantum("quantum", sc_time(1, SC_US)),
-    duration("duration", SC_ZERO_TIME) {
+    duration("duration", SC_ZERO_TIME),
+    async_deterministic("async_deterministic", false),
+    input_record("input_record", ""),
+    input_replay("input_replay", "") {
     if (backtrace)
         mwr::report_segfaults();
 
     if (duration > SC_ZERO_TIME)
         SC_THREAD(timeout);
 
+    register_command("sc_profile", 0, &system::cmd_sc_profile,
+                     "prints the SystemC processes that used the most host "
+                     "time, usage: sc_profile [n]");
+
+    sc_async_set_deterministic(async_deterministic);
+
+    if (!input_record.get().empty() && !input_replay.get().empty())
+        log_warn("cannot record and replay inputs at the same time");
+    else if (!input_record.get().empty())
+        replay::instance().start_recording(input_record);
+    else if (!input_replay.get().empty())
+        replay::instance().start_playback(input_replay);
+
     if (config.get().empty())
         log_warn("no configuration specified, use -f <config>");
 }
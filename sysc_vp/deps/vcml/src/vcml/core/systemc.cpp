@@ -567,16 +567,99 @@ void async_timer::reset(const sc_time& delta) {
 
 thread_local struct async_worker* g_async = nullptr;
 
+// Releases all async threads at the same quantum boundaries: threads that
+// ran a full quantum ahead of the kernel block until the kernel reaches the
+// next boundary, so the kernel can process device events in the meantime.
+struct async_scheduler {
+    mutex mtx;
+    condition_variable_any release;
+
+    atomic<bool> deterministic;
+    atomic<u64> epoch;
+
+    size_t active;
+    bool spawned;
+    sc_event activate;
+
+    async_scheduler():
+        mtx(),
+        release(),
+        deterministic(false),
+        epoch(0),
+        active(0),
+        spawned(false),
+        activate() {}
+
+    sc_time quantum_base() const {
+        return deterministic ? time_from_value(epoch) : sc_time_stamp();
+    }
+
+    void tick() {
+        while (true) {
+            while (active == 0)
+                sc_core::wait(activate);
+
+            // async threads cannot run ahead without a quantum
+            const sc_time& quantum = tlm::tlm_global_quantum::instance().get();
+            if (quantum == SC_ZERO_TIME) {
+                sc_core::wait(activate);
+                continue;
+            }
+
+            u64 now = sc_time_stamp().value();
+            epoch = now - now % quantum.value();
+            sc_core::wait(quantum - time_from_value(now % quantum.value()));
+
+            mtx.lock();
+            epoch = sc_time_stamp().value();
+            mtx.unlock();
+            release.notify_all();
+        }
+    }
+
+    void start() {
+        if (!spawned) {
+            spawned = true;
+            sc_spawn([&]() -> void { tick(); }, "$$$$vcml_quantum$$$$");
+        }
+
+        if (active++ == 0)
+            activate.notify();
+    }
+
+    void stop() { active--; }
+
+    static async_scheduler& instance() {
+        static async_scheduler scheduler;
+        return scheduler;
+    }
+};
+
 struct async_worker {
     const size_t id;
     sc_process_b* const process;
 
     atomic<bool> alive;
     atomic<bool> working;
+    atomic<bool> waiting;
     function<void(void)> task;
 
     atomic<u64> progress;
-    atomic<function<void(void)>*> request;
+
+    // sc_sync and sc_post requests, served in order by the SystemC thread;
+    // served counts completed requests and doubles as the futex word that
+    // blocking requesters sleep on once spinning no longer pays off
+    mutex reqmtx;
+    deque<function<void(void)>> requests;
+    atomic<size_t> pending;
+    atomic<u32> served;
+    atomic<bool> sleeping;
+    u32 posted;
+    size_t spin_limit;
+
+    static constexpr size_t MIN_SPINS = 16;
+    static constexpr size_t MAX_SPINS = 16384;
+    static constexpr u64 SLEEP_US = 1000;
 
     mutex mtx;
     condition_variable_any notify;
@@ -591,9 +674,16 @@ struct async_worker {
         process(worker_proc),
         alive(true),
         working(false),
+        waiting(false),
         task(),
         progress(0),
-        request(nullptr),
+        reqmtx(),
+        requests(),
+        pending(0),
+        served(0),
+        sleeping(false),
+        posted(0),
+        spin_limit(MAX_SPINS),
         mtx(),
         notify(),
         worker(&async_worker::work, this),
@@ -642,42 +732,127 @@ struct async_worker {
         }
     }
 
+    // worker thread has stopped at a point where it waits for the kernel
+    bool stopped() const { return !working || pending || waiting; }
+
+    void serve_requests() {
+        deque<function<void(void)>> batch;
+        reqmtx.lock();
+        batch.swap(requests);
+        reqmtx.unlock();
+
+        for (auto& job : batch)
+            job();
+
+        pending -= batch.size();
+        served += batch.size();
+        if (sleeping)
+            thctl_futex_wake(served);
+    }
+
     void run_async(function<void(void)>& job) {
+        async_scheduler& scheduler = async_scheduler::instance();
+        scheduler.start();
+
         mtx.lock();
+        sc_thread_pos = sc_time_stamp();
         task = job;
         working = true;
         mtx.unlock();
         notify.notify_one();
 
         while (working) {
+            // in deterministic mode, time only advances and requests only
+            // get served once the worker stopped, so that this happens at
+            // the same simulation time and order in every run
+            while (scheduler.deterministic && !stopped())
+                mwr::cpu_yield();
+
             u64 p = progress.exchange(0);
             sc_thread_pos = sc_time_stamp() + time_from_value(p);
             sc_core::wait(time_from_value(p));
 
-            if (request) {
+            if (pending) {
                 p = progress.exchange(0);
                 if (p > 0) {
                     sc_thread_pos = sc_time_stamp() + time_from_value(p);
                     sc_core::wait(time_from_value(p));
                 }
 
-                (*request)();
-                request = nullptr;
+                serve_requests();
             }
         }
 
         u64 p = progress.exchange(0);
         if (p > 0)
             sc_core::wait(time_from_value(p));
+
+        if (pending)
+            serve_requests();
+
+        scheduler.stop();
     }
 
-    void run_sync(function<void(void)> job) {
-        g_async->request = &job;
-        while (g_async->request) {
-            if (!g_async->alive || !sim_running())
+    void wait_quantum(const sc_time& quantum) {
+        async_scheduler& scheduler = async_scheduler::instance();
+        scheduler.mtx.lock();
+        waiting = true;
+
+        // time out periodically to notice the end of simulation
+        while (alive && sim_running() &&
+               timestamp() - scheduler.quantum_base() >= quantum) {
+            scheduler.release.wait_for(scheduler.mtx,
+                                       std::chrono::milliseconds(10));
+        }
+
+        waiting = false;
+        scheduler.mtx.unlock();
+    }
+
+    u32 post(function<void(void)>&& job) {
+        reqmtx.lock();
+        requests.push_back(std::move(job));
+        pending++;
+        reqmtx.unlock();
+        return ++posted;
+    }
+
+    bool is_served(u32 seqno) const { return (i32)(seqno - served) <= 0; }
+
+    // spins while the kernel usually answers quickly, otherwise sleeps on
+    // the served counter; the spin budget adapts to recent response times
+    void wait_served(u32 seqno) {
+        size_t spins = 0;
+        while (!is_served(seqno)) {
+            if (!alive || !sim_running())
                 throw sim_terminated_exception();
-            mwr::cpu_yield();
+
+            if (spins++ < spin_limit) {
+                mwr::cpu_yield();
+                continue;
+            }
+
+            sleeping = true;
+            u32 val = served;
+            if ((i32)(seqno - val) > 0)
+                thctl_futex_wait(served, val, SLEEP_US);
+            sleeping = false;
         }
+
+        if (spins <= spin_limit)
+            spin_limit = min(spin_limit * 2, MAX_SPINS);
+        else
+            spin_limit = max(spin_limit / 2, MIN_SPINS);
+    }
+
+    void run_sync(function<void(void)>&& job) {
+        wait_served(post(std::move(job)));
+    }
+
+    void run_post(function<void(void)>&& job) {
+        u32 seqno = post(std::move(job));
+        if (async_scheduler::instance().deterministic)
+            wait_served(seqno);
     }
 
     sc_time timestamp() { return sc_thread_pos + time_from_value(progress); }
@@ -724,10 +899,33 @@ void sc_sync(function<void(void)> job) {
     }
 }
 
+void sc_post(function<void(void)> job) {
+    if (thctl_is_sysc_thread()) {
+        job();
+    } else if (g_async != nullptr) {
+        g_async->run_post(std::move(job));
+    } else {
+        VCML_ERROR("not on systemc or async thread");
+    }
+}
+
 void sc_join_async() {
     async_worker::all_workers().clear();
 }
 
+void sc_async_wait_quantum(const sc_time& quantum) {
+    VCML_ERROR_ON(!g_async, "no async thread to wait for quantum");
+    g_async->wait_quantum(quantum);
+}
+
+void sc_async_set_deterministic(bool deterministic) {
+    async_scheduler::instance().deterministic = deterministic;
+}
+
+bool sc_async_is_deterministic() {
+    return async_scheduler::instance().deterministic;
+}
+
 bool sc_is_async() {
     return g_async != nullptr;
 }
@@ -739,7 +937,11 @@ sc_time async_time_stamp() {
 }
 
 sc_time async_time_offset() {
-    return async_time_stamp() - sc_time_stamp();
+    if (!sc_is_async())
+        return SC_ZERO_TIME;
+
+    async_scheduler& scheduler = async_scheduler::instance();
+    return g_async->timestamp() - scheduler.quantum_base();
 }
 
 bool is_thread(sc_process_b* proc) {
@@ -11,8 +11,20 @@
 #include "vcml/core/thctl.h"
 #include "vcml/core/systemc.h"
 
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 namespace vcml {
 
+struct thctl_request {
+    function<void(void)> job;
+    atomic<u32>* done;
+    thctl_request* next;
+};
+
 struct thctl {
     thread::id sysc_thread;
     atomic<thread::id> curr_owner;
@@ -21,6 +33,8 @@ struct thctl {
     atomic<int> nwaiting;
     condition_variable_any cvar;
 
+    atomic<thctl_request*> requests;
+
     thctl();
     ~thctl();
 
@@ -38,6 +52,10 @@ struct thctl {
 
     void set_sysc_thread(thread::id id);
 
+    void post(thctl_request* req);
+    void call(function<void(void)>&& job);
+    void drain();
+
     static thctl& instance();
 };
 
@@ -46,7 +64,8 @@ thctl::thctl():
     curr_owner(sysc_thread),
     sysc_mutex(),
     nwaiting(0),
-    cvar() {
+    cvar(),
+    requests(nullptr) {
     sysc_mutex.lock();
 }
 
@@ -120,12 +139,70 @@ void thctl::suspend() {
 void thctl::flush() {
     if (nwaiting > 0)
         suspend();
+    drain();
 }
 
 void thctl::set_sysc_thread(thread::id id) {
     sysc_thread = id;
 }
 
+void thctl::post(thctl_request* req) {
+    thctl_request* head = requests.load(std::memory_order_relaxed);
+    do {
+        req->next = head;
+    } while (!requests.compare_exchange_weak(head, req,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed));
+
+    // only the first request of a batch needs to wake up the kernel
+    if (head == nullptr)
+        on_next_update([this]() -> void { drain(); });
+}
+
+void thctl::call(function<void(void)>&& job) {
+    if (is_sysc_thread() || !sim_running()) {
+        job();
+        return;
+    }
+
+    atomic<u32> done(0);
+    thctl_request req{ std::move(job), &done, nullptr };
+    post(&req);
+
+    // time out periodically in case the wakeup got lost
+    while (done == 0)
+        thctl_futex_wait(done, 0, 1000);
+}
+
+void thctl::drain() {
+    thctl_request* head = requests.exchange(nullptr,
+                                            std::memory_order_acquire);
+
+    // requests are pushed in reverse order, so restore posting order first
+    thctl_request* list = nullptr;
+    while (head != nullptr) {
+        thctl_request* next = head->next;
+        head->next = list;
+        list = head;
+        head = next;
+    }
+
+    while (list != nullptr) {
+        thctl_request* req = list;
+        atomic<u32>* done = req->done;
+        list = req->next;
+
+        req->job();
+
+        if (done == nullptr) {
+            delete req;
+        } else {
+            *done = 1;
+            thctl_futex_wake(*done);
+        }
+    }
+}
+
 thctl& thctl::instance() {
     static thctl singleton;
     return singleton;
@@ -170,4 +247,35 @@ void thctl_set_sysc_thread(thread::id id) {
     thctl::instance().set_sysc_thread(id);
 }
 
+void thctl_post(function<void(void)> job) {
+    thctl::instance().post(new thctl_request{ std::move(job), nullptr });
+}
+
+void thctl_call(function<void(void)> job) {
+    thctl::instance().call(std::move(job));
+}
+
+void thctl_futex_wait(atomic<u32>& word, u32 val, u64 timeout_us) {
+#ifdef __linux__
+    struct timespec ts;
+    ts.tv_sec = timeout_us / 1000000;
+    ts.tv_nsec = (timeout_us % 1000000) * 1000;
+    syscall(SYS_futex, reinterpret_cast<u32*>(&word), FUTEX_WAIT_PRIVATE,
+            val, &ts, nullptr, 0);
+#else
+    // platforms without futexes only yield the remaining timeslice
+    if (word == val)
+        std::this_thread::yield();
+#endif
+}
+
+void thctl_futex_wake(atomic<u32>& word) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<u32*>(&word), FUTEX_WAKE_PRIVATE,
+            INT32_MAX, nullptr, nullptr, 0);
+#else
+    (void)word;
+#endif
+}
+
 } // namespace vcml
@@ -0,0 +1,97 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "vcml/debugging/profiler.h"
+
+namespace vcml {
+namespace debugging {
+
+string profiler::symbol_name(u64 addr) const {
+    const symbol* sym = m_symbols.find_function(addr);
+    if (sym != nullptr)
+        return sym->name();
+    return mkstr("0x%016llx", addr);
+}
+
+u64 profiler::hits(u64 addr) const {
+    auto it = m_hits.find(addr);
+    return it != m_hits.end() ? it->second : 0;
+}
+
+profiler::profiler(const symtab& syms):
+    m_symbols(syms), m_samples(0), m_hits(), m_stacks() {
+    // nothing to do
+}
+
+void profiler::reset() {
+    m_samples = 0;
+    m_hits.clear();
+    m_stacks.clear();
+}
+
+void profiler::sample(u64 pc) {
+    m_hits[pc]++;
+    m_samples++;
+}
+
+void profiler::sample(const vector<stackframe>& frames) {
+    if (frames.empty())
+        return;
+
+    sample(frames.front().program_counter);
+
+    // folded stacks list the outermost frame first
+    string stack;
+    for (auto it = frames.rbegin(); it != frames.rend(); it++) {
+        if (!stack.empty())
+            stack += ';';
+        if (it->sym != nullptr)
+            stack += it->sym->name();
+        else
+            stack += symbol_name(it->program_counter);
+    }
+
+    m_stacks[stack]++;
+}
+
+void profiler::write_flat(ostream& os, size_t limit) const {
+    unordered_map<string, u64> functions;
+    for (const auto& hit : m_hits)
+        functions[symbol_name(hit.first)] += hit.second;
+
+    vector<pair<string, u64>> sorted(functions.begin(), functions.end());
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.second != b.second ? a.second > b.second : a.first < b.first;
+    });
+
+    stream_guard guard(os);
+    os << "samples: " << m_samples << std::endl;
+    os << "      %    samples  function" << std::endl;
+    for (size_t i = 0; i < sorted.size() && i < limit; i++) {
+        double pct = m_samples ? 100.0 * sorted[i].second / m_samples : 0.0;
+        os << std::fixed << std::setprecision(2) << std::setw(7) << pct
+           << std::setw(11) << sorted[i].second << "  " << sorted[i].first
+           << std::endl;
+    }
+}
+
+void profiler::write_folded(ostream& os) const {
+    if (m_stacks.empty()) {
+        for (const auto& hit : m_hits)
+            os << symbol_name(hit.first) << " " << hit.second << std::endl;
+        return;
+    }
+
+    for (const auto& stack : m_stacks)
+        os << stack.first << " " << stack.second << std::endl;
+}
+
+} // namespace debugging
+} // namespace vcml
@@ -9,6 +9,8 @@
  ******************************************************************************/
 
 #include "vcml/models/can/bridge.h"
+#include "vcml/core/thctl.h"
+#include "vcml/core/replay.h"
 
 namespace vcml {
 namespace can {
@@ -72,6 +74,12 @@ void bridge::can_transmit() {
         while (!m_rx.empty()) {
             can_frame frame = m_rx.front();
             m_rx.pop();
+
+            replay& rep = replay::instance();
+            if (rep.is_replaying())
+                continue; // host input is replaced by the replay log
+
+            rep.record(name(), &frame, sizeof(frame));
             can_tx.send(frame);
         }
     }
@@ -105,6 +113,12 @@ bridge::bridge(const sc_module_name& nm):
         }
     }
 
+    replay::instance().attach(name(), [&](const vector<u8>& data) -> void {
+        can_frame frame{};
+        memcpy(&frame, data.data(), min(data.size(), sizeof(frame)));
+        can_tx.send(frame);
+    });
+
     SC_HAS_PROCESS(bridge);
     SC_THREAD(can_transmit);
 
@@ -123,6 +137,7 @@ bridge::~bridge() {
         delete it.second;
 
     bridges().erase(name());
+    replay::instance().detach(name());
 }
 
 void bridge::send_to_host(const can_frame& frame) {
@@ -133,7 +148,7 @@ void bridge::send_to_host(const can_frame& frame) {
 void bridge::send_to_guest(can_frame frame) {
     lock_guard<mutex> guard(m_mtx);
     m_rx.push(frame);
-    on_next_update([&]() -> void { m_ev.notify(SC_ZERO_TIME); });
+    thctl_post([this]() -> void { m_ev.notify(SC_ZERO_TIME); });
 }
 
 void bridge::attach(backend* b) {
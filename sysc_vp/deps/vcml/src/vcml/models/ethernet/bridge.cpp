@@ -9,6 +9,8 @@
  ******************************************************************************/
 
 #include "vcml/models/ethernet/bridge.h"
+#include "vcml/core/thctl.h"
+#include "vcml/core/replay.h"
 
 namespace vcml {
 namespace ethernet {
@@ -72,6 +74,12 @@ void bridge::eth_transmit() {
         while (!m_rx.empty()) {
             eth_frame frame = std::move(m_rx.front());
             m_rx.pop();
+
+            replay& rep = replay::instance();
+            if (rep.is_replaying())
+                continue; // host input is replaced by the replay log
+
+            rep.record(name(), frame.data(), frame.size());
             eth_tx.send(frame);
         }
     }
@@ -105,6 +113,10 @@ bridge::bridge(const sc_module_name& nm):
         }
     }
 
+    replay::instance().attach(name(), [&](const vector<u8>& data) -> void {
+        eth_tx.send(data);
+    });
+
     SC_HAS_PROCESS(bridge);
     SC_THREAD(eth_transmit);
 
@@ -123,6 +135,7 @@ bridge::~bridge() {
         delete it.second;
 
     bridges().erase(name());
+    replay::instance().detach(name());
 }
 
 void bridge::send_to_host(const eth_frame& frame) {
@@ -133,7 +146,7 @@ void bridge::send_to_host(const eth_frame& frame) {
 void bridge::send_to_guest(eth_frame frame) {
     lock_guard<mutex> guard(m_mtx);
     m_rx.push(std::move(frame));
-    on_next_update([&]() -> void { m_ev.notify(SC_ZERO_TIME); });
+    thctl_post([this]() -> void { m_ev.notify(SC_ZERO_TIME); });
 }
 
 void bridge::attach(backend* b) {
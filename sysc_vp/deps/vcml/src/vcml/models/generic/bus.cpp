@@ -90,6 +90,15 @@ const bus::mapping& bus::lookup(tlm_target_socket& s, const range& mem) const {
     return m_default;
 }
 
+size_t bus::lookup_sg(tlm_target_socket& s, const mapping& m,
+                      const tlm_generic_payload& tx, const sgext& sg) const {
+    // only forward segments that are routed to the same target as the payload
+    size_t n = 0;
+    while (n < sg.count() && &lookup(s, sg.local_range(tx, n)) == &m)
+        n++;
+    return n;
+}
+
 void bus::handle_bus_error(tlm_generic_payload& tx) const {
     if (lenient) {
         if (tx.is_read())
@@ -144,10 +153,18 @@ void bus::b_transport(tlm_target_socket& socket, tlm_generic_payload& tx,
         return;
     }
 
+    sgext* sg = tx.get_extension<sgext>();
+    size_t limit = sg ? sg->limit : 0;
+    if (sg != nullptr)
+        sg->limit = lookup_sg(socket, m, tx, *sg);
+
     u64 addr = tx.get_address();
     tx.set_address(addr - m.addr.start + m.offset);
     out[m.target].b_transport(tx, dt);
     tx.set_address(addr);
+
+    if (sg != nullptr)
+        sg->limit = limit;
 }
 
 unsigned int bus::transport_dbg(tlm_target_socket& origin,
@@ -158,10 +175,19 @@ unsigned int bus::transport_dbg(tlm_target_socket& origin,
         return 0;
     }
 
+    sgext* sg = tx.get_extension<sgext>();
+    size_t limit = sg ? sg->limit : 0;
+    if (sg != nullptr)
+        sg->limit = lookup_sg(origin, m, tx, *sg);
+
     u64 addr = tx.get_address();
     tx.set_address(addr - m.addr.start + m.offset);
     unsigned int n = out[m.target]->transport_dbg(tx);
     tx.set_address(addr);
+
+    if (sg != nullptr)
+        sg->limit = limit;
+
     return n;
 }
 
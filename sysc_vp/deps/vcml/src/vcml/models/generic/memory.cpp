@@ -41,6 +41,55 @@ bool memory::cmd_show(const vector<string>& args, ostream& os) {
     return true;
 }
 
+bool memory::cmd_snapshot(const vector<string>& args, ostream& os) {
+    const string& filename = args[0];
+    bool full = args.size() > 1 && args[1] == "full";
+    if (!full && !m_memory.is_tracking_dirty()) {
+        os << "dirty page tracking disabled, use 'full' snapshots";
+        return false;
+    }
+
+    ofstream file(filename.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        os << "cannot open file '" << filename << "'";
+        return false;
+    }
+
+    size_t pages = m_memory.save_snapshot(file, full);
+    os << "saved " << pages << " of " << m_memory.count_pages()
+       << " pages to " << filename;
+    return true;
+}
+
+bool memory::cmd_restore(const vector<string>& args, ostream& os) {
+    const string& filename = args[0];
+    ifstream file(filename.c_str(), std::ios::binary);
+    if (!file.is_open()) {
+        os << "cannot open file '" << filename << "'";
+        return false;
+    }
+
+    if (!m_memory.load_snapshot(file)) {
+        os << "invalid snapshot file '" << filename << "'";
+        return false;
+    }
+
+    os << "restored snapshot " << filename;
+    return true;
+}
+
+void memory::load_bin(const string& filename, u64 offset) {
+    // mapping the file directly avoids reading the entire image on every
+    // reset; remapping also discards all modifications from the last run
+    if (cow_images && m_memory.map_file(filename, offset)) {
+        log_debug("mapped binary file '%s' to offset 0x%llx",
+                  filename.c_str(), offset);
+        return;
+    }
+
+    loader::load_bin(filename, offset);
+}
+
 u8* memory::allocate_image(u64 sz, u64 off) {
     if (off >= size)
         VCML_REPORT("offset 0x%llx exceeds memory size", off);
@@ -48,6 +97,8 @@ u8* memory::allocate_image(u64 sz, u64 off) {
     if (sz + off > size)
         VCML_REPORT("image too big for memory");
 
+    // image data may get read directly from file into write protected pages
+    m_memory.mark_dirty({ off, off + sz - 1 });
     return m_memory.data() + off;
 }
 
@@ -73,11 +124,32 @@ memory::memory(const sc_module_name& nm, u64 sz, bool read_only, alignment al,
     shared("shared", ""),
     images("images"),
     poison("poison", 0x00),
+    hugepages("hugepages", false),
+    hugetlb("hugetlb", false),
+    prefault("prefault", false),
+    numa_node("numa_node", -1),
+    cow_images("cow_images", false),
+    dirty_tracking("dirty_tracking", false),
     in("in") {
     VCML_ERROR_ON(size == 0u, "memory size cannot be 0");
     VCML_ERROR_ON(al > VCML_ALIGN_1G, "requested alignment too big");
 
+    m_memory.use_hugepages(hugepages);
+    m_memory.use_hugetlb(hugetlb);
+    m_memory.prefault(prefault);
+    m_memory.bind_numa_node(numa_node);
     m_memory.init(shared, size, align);
+
+    if (hugetlb && !m_memory.is_hugetlb())
+        log_warn("huge pages unavailable, falling back to regular pages");
+    if (hugepages && !m_memory.is_hugetlb() && !m_memory.is_hugepages())
+        log_warn("transparent huge pages unavailable");
+
+    if (hugepages || hugetlb || prefault || numa_node >= 0) {
+        const char* thp = m_memory.is_hugepages() ? " (transparent)" : "";
+        log_info("using %zu KiB pages%s", m_memory.page_size() / KiB, thp);
+    }
+
     m_memory.set_read_latency(read_cycles());
     m_memory.set_write_latency(write_cycles());
 
@@ -88,8 +160,16 @@ memory::memory(const sc_module_name& nm, u64 sz, bool read_only, alignment al,
 
     map_dmi(m_memory);
 
+    if (dirty_tracking && !m_memory.track_dirty())
+        log_warn("dirty page tracking unavailable");
+
     register_command("show", 2, &memory::cmd_show,
                      "show [start] [end] to print memory contents");
+    register_command("snapshot", 1, &memory::cmd_snapshot,
+                     "snapshot <file> [full] to store all pages modified "
+                     "since the last snapshot, or all pages if full is given");
+    register_command("restore", 1, &memory::cmd_restore,
+                     "restore <file> to load pages from a snapshot file");
 }
 
 memory::~memory() {
@@ -103,6 +183,33 @@ void memory::reset() {
     load_images(images);
 }
 
+unsigned int memory::transport(tlm_generic_payload& tx, const tlm_sbi& info,
+                               address_space as) {
+    // memory has no registers, so streaming, byte enables and scatter-gather
+    // are handled directly instead of splitting them up into single beats
+    VCML_ERROR_ON(tx.get_data_ptr() == nullptr,
+                  "transaction data pointer cannot be null");
+    VCML_ERROR_ON(tx.get_data_length() == 0,
+                  "transaction data length cannot be zero");
+
+    unsigned int bytes = m_memory.transport(tx, info);
+
+    if (!info.is_debug) {
+        u64 beats = tx.get_data_length() / tx_size(tx);
+        if (const sgext* sg = tx.get_extension<sgext>())
+            beats += sg->completed;
+
+        local_time() += (tx.is_read() ? read_cycles() : write_cycles()) *
+                        (double)beats;
+
+        // check for quantum overshoot
+        if (needs_sync())
+            sync(TLM_SYNC_OVERSHOOT);
+    }
+
+    return bytes;
+}
+
 tlm_response_status memory::read(const range& addr, void* data,
                                  const tlm_sbi& info) {
     return m_memory.read(addr, data, info.is_debug);
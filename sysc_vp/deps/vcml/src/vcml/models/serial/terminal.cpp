@@ -9,6 +9,8 @@
  ******************************************************************************/
 
 #include "vcml/models/serial/terminal.h"
+#include "vcml/core/thctl.h"
+#include "vcml/core/replay.h"
 
 namespace vcml {
 namespace serial {
@@ -117,10 +119,15 @@ bool terminal::cmd_history(const vector<string>& args, ostream& os) {
 }
 
 void terminal::serial_transmit() {
+    replay& rep = replay::instance();
     while (true) {
         for (backend* b : m_listeners) {
             u8 data = 0xff;
             while (b->read(data)) {
+                if (rep.is_replaying())
+                    continue; // host input is replaced by the replay log
+
+                rep.record(name(), &data, sizeof(data));
                 serial_tx.send(data);
                 if (!untimed)
                     wait(serial_tx.cycle());
@@ -131,6 +138,14 @@ void terminal::serial_transmit() {
     }
 }
 
+void terminal::serial_replay(const vector<u8>& data) {
+    for (u8 val : data) {
+        serial_tx.send(val);
+        if (!untimed)
+            wait(serial_tx.cycle());
+    }
+}
+
 void terminal::serial_receive(u8 data) {
     m_hist.insert(data);
     for (backend* b : m_listeners)
@@ -191,6 +206,10 @@ terminal::terminal(const sc_module_name& nm):
     register_command("history", 0, this, &terminal::cmd_history,
                      "show previously transmitted data from this terminal");
 
+    replay::instance().attach(name(), [&](const vector<u8>& data) -> void {
+        serial_replay(data);
+    });
+
     SC_HAS_PROCESS(terminal);
     SC_THREAD(serial_transmit);
 }
@@ -200,6 +219,7 @@ terminal::~terminal() {
         delete it.second;
 
     terminals().erase(name());
+    replay::instance().detach(name());
 }
 
 void terminal::attach(backend* b) {
@@ -215,7 +235,7 @@ void terminal::detach(backend* b) {
 }
 
 void terminal::notify(backend* b) {
-    on_next_update([&] { m_async_ev.notify(SC_ZERO_TIME); });
+    thctl_post([this]() -> void { m_async_ev.notify(SC_ZERO_TIME); });
 }
 
 size_t terminal::create_backend(const string& type) {
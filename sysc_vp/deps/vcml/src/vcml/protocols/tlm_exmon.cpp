@@ -12,8 +12,61 @@
 
 namespace vcml {
 
+static u64 granules(const range& r, u64 bits) {
+    return (r.end >> bits) - (r.start >> bits) + 1;
+}
+
+void tlm_exmon::index(const range& r) {
+    if (granules(r, GRANULE_BITS) > MAX_GRANULES) {
+        m_unindexed++;
+        return;
+    }
+
+    for (u64 g = r.start >> GRANULE_BITS; g <= r.end >> GRANULE_BITS; g++)
+        m_index[g]++;
+}
+
+void tlm_exmon::unindex(const range& r) {
+    if (granules(r, GRANULE_BITS) > MAX_GRANULES) {
+        m_unindexed--;
+        return;
+    }
+
+    for (u64 g = r.start >> GRANULE_BITS; g <= r.end >> GRANULE_BITS; g++) {
+        auto it = m_index.find(g);
+        if (it != m_index.end() && --it->second == 0)
+            m_index.erase(it);
+    }
+}
+
+bool tlm_exmon::overlaps(const range& r) const {
+    if (!is_indexed(r))
+        return false;
+
+    for (const exlock& lock : m_locks)
+        if (lock.addr.overlaps(r))
+            return true;
+    return false;
+}
+
+bool tlm_exmon::is_indexed(const range& r) const {
+    if (m_locks.empty())
+        return false;
+
+    // for large ranges, checking all locks directly is cheaper
+    if (m_unindexed > 0 || granules(r, GRANULE_BITS) > m_locks.size())
+        return true;
+
+    u64 first = r.start >> GRANULE_BITS;
+    u64 last = r.end >> GRANULE_BITS;
+    for (u64 g = first; g <= last; g++)
+        if (m_index.count(g))
+            return true;
+    return false;
+}
+
 bool tlm_exmon::has_lock(int cpu, const range& r) const {
-    for (auto lock : m_locks)
+    for (const exlock& lock : m_locks)
         if (lock.cpu == cpu && lock.addr.includes(r))
             return true;
     return false;
@@ -23,30 +76,39 @@ bool tlm_exmon::add_lock(int cpu, const range& r) {
     assert(cpu >= 0);
     break_locks(cpu);
     m_locks.push_back({ cpu, r });
+    index(r);
     return true;
 }
 
 void tlm_exmon::break_locks(int cpu) {
     assert(cpu >= 0);
     m_locks.erase(std::remove_if(m_locks.begin(), m_locks.end(),
-                                 [cpu](const exlock& lock) -> bool {
-                                     return lock.cpu == cpu;
+                                 [&](const exlock& lock) -> bool {
+                                     if (lock.cpu != cpu)
+                                         return false;
+                                     unindex(lock.addr);
+                                     return true;
                                  }),
                   m_locks.end());
 }
 
 void tlm_exmon::break_locks(const range& r) {
+    if (!is_indexed(r))
+        return;
+
     m_locks.erase(std::remove_if(m_locks.begin(), m_locks.end(),
-                                 [r](const exlock& lock) -> bool {
-                                     return lock.addr.overlaps(r);
+                                 [&](const exlock& lock) -> bool {
+                                     if (!lock.addr.overlaps(r))
+                                         return false;
+                                     unindex(lock.addr);
+                                     return true;
                                  }),
                   m_locks.end());
 }
 
 bool tlm_exmon::update(tlm_generic_payload& tx) {
-    for (auto lock : m_locks)
-        if (lock.addr.overlaps(tx))
-            tx.set_dmi_allowed(false);
+    if (overlaps(tx))
+        tx.set_dmi_allowed(false);
 
     bool proceed = true;
     sbiext* ex = tx.get_extension<sbiext>();
@@ -58,9 +120,14 @@ bool tlm_exmon::update(tlm_generic_payload& tx) {
         proceed = ex->is_excl;
     }
 
-    if (tx.is_write())
+    if (tx.is_write()) {
         break_locks(tx); // increase range to invalidate entire cache line?
 
+        const sgext* sg = tx.get_extension<sgext>();
+        for (size_t i = 0; sg != nullptr && i < sg->count(); i++)
+            break_locks(sg->local_range(tx, i));
+    }
+
     return proceed;
 }
 
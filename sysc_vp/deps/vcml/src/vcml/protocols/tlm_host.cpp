@@ -13,6 +13,136 @@
 
 namespace vcml {
 
+const char* tlm_sync_reason_str(tlm_sync_reason reason) {
+    switch (reason) {
+    case TLM_SYNC_EXPLICIT:
+        return "explicit";
+    case TLM_SYNC_QUANTUM:
+        return "quantum";
+    case TLM_SYNC_TRANSACTION:
+        return "transaction";
+    case TLM_SYNC_REGISTER:
+        return "register";
+    case TLM_SYNC_OVERSHOOT:
+        return "overshoot";
+    default:
+        return "unknown";
+    }
+}
+
+void tlm_sync_stats::reset() {
+    num_checks = 0;
+    for (size_t i = 0; i < NUM_TLM_SYNC_REASONS; i++) {
+        syncs[i] = 0;
+        offsets[i] = SC_ZERO_TIME;
+    }
+
+    num_overshoots = 0;
+    total_overshoot = SC_ZERO_TIME;
+    max_overshoot = SC_ZERO_TIME;
+}
+
+u64 tlm_sync_stats::num_syncs() const {
+    u64 n = 0;
+    for (u64 count : syncs)
+        n += count;
+    return n;
+}
+
+u64 tlm_sync_stats::num_forced_syncs() const {
+    return num_syncs() - syncs[TLM_SYNC_QUANTUM];
+}
+
+sc_time tlm_sync_stats::mean_forced_offset() const {
+    u64 forced = num_forced_syncs();
+    if (forced == 0)
+        return SC_ZERO_TIME;
+
+    sc_time total = SC_ZERO_TIME;
+    for (size_t i = 0; i < NUM_TLM_SYNC_REASONS; i++) {
+        if (i != TLM_SYNC_QUANTUM)
+            total += offsets[i];
+    }
+
+    return total / (double)forced;
+}
+
+sc_time tlm_sync_stats::mean_overshoot() const {
+    if (num_overshoots == 0)
+        return SC_ZERO_TIME;
+    return total_overshoot / (double)num_overshoots;
+}
+
+void tlm_sync_stats::count(tlm_sync_reason reason, const sc_time& offset,
+                           const sc_time& quantum) {
+    syncs[reason]++;
+    offsets[reason] += offset;
+
+    if (quantum > SC_ZERO_TIME && offset > quantum) {
+        sc_time overshoot = offset - quantum;
+        num_overshoots++;
+        total_overshoot += overshoot;
+        if (overshoot > max_overshoot)
+            max_overshoot = overshoot;
+    }
+}
+
+void tlm_sync_stats::merge(const tlm_sync_stats& other) {
+    num_checks += other.num_checks;
+    for (size_t i = 0; i < NUM_TLM_SYNC_REASONS; i++) {
+        syncs[i] += other.syncs[i];
+        offsets[i] += other.offsets[i];
+    }
+
+    num_overshoots += other.num_overshoots;
+    total_overshoot += other.total_overshoot;
+    if (other.max_overshoot > max_overshoot)
+        max_overshoot = other.max_overshoot;
+}
+
+// rounds up to the next value in the 1-2-5 series, e.g. 1us, 2us, 5us, 10us
+static sc_time round_quantum(const sc_time& t) {
+    u64 ns = max<u64>(time_to_ns(t), 1);
+    u64 decade = 1;
+    while (true) {
+        for (u64 step : { 1, 2, 5 }) {
+            if (ns <= step * decade)
+                return sc_time((double)(step * decade), SC_NS);
+        }
+
+        decade *= 10;
+    }
+}
+
+sc_time tlm_sync_stats::suggest_quantum(const sc_time& quantum) const {
+    u64 periodic = syncs[TLM_SYNC_QUANTUM];
+    u64 forced = num_forced_syncs();
+    if (periodic + forced == 0)
+        return quantum;
+
+    if (periodic > forced)
+        return round_quantum(quantum * 2.0);
+
+    return round_quantum(mean_forced_offset() * 2.0);
+}
+
+void tlm_sync_stats::print(ostream& os, const sc_time& quantum) const {
+    os << "syncs: " << num_syncs() << " of " << num_checks << " checks";
+    for (size_t i = 0; i < NUM_TLM_SYNC_REASONS; i++) {
+        if (syncs[i] == 0)
+            continue;
+
+        sc_time mean = offsets[i] / (double)syncs[i];
+        os << "\n  " << tlm_sync_reason_str((tlm_sync_reason)i) << ": "
+           << syncs[i] << ", mean offset " << mean;
+    }
+
+    os << "\novershoots: " << num_overshoots << ", mean " << mean_overshoot()
+       << ", max " << max_overshoot;
+    os << "\nquantum: " << quantum << ", suggested "
+       << suggest_quantum(quantum);
+}
+
 unsigned int tlm_host::do_transport(tlm_target_socket& socket,
                                     tlm_generic_payload& tx,
                                     const tlm_sbi& info) {
@@ -81,6 +211,7 @@ vector<tlm_target_socket*> tlm_host::find_tlm_target_sockets(
 
 tlm_host::tlm_host(bool allow_dmi, unsigned int bus_width):
     m_processes(),
+    m_sync_stats(),
     m_initiator_sockets(),
     m_target_sockets(),
     allow_dmi("allow_dmi", allow_dmi) {
@@ -103,15 +234,23 @@ bool tlm_host::needs_sync(sc_process_b* proc) {
     if (!is_thread(proc))
         return false;
 
+    m_sync_stats.num_checks++;
     sc_time quantum = tlm::tlm_global_quantum::instance().get();
     return local_time(proc) >= quantum;
 }
 
 void tlm_host::sync(sc_process_b* proc) {
+    sync(TLM_SYNC_EXPLICIT, proc);
+}
+
+void tlm_host::sync(tlm_sync_reason reason, sc_process_b* proc) {
     if (proc == nullptr || proc->proc_kind() != sc_core::SC_THREAD_PROC_)
         VCML_ERROR("attempt to sync outside of SC_THREAD process");
 
     sc_time& offset = local_time(proc);
+    const sc_time& quantum = tlm::tlm_global_quantum::instance().get();
+    m_sync_stats.count(reason, offset, quantum);
+
     sc_core::wait(offset);
     offset = SC_ZERO_TIME;
 }
@@ -0,0 +1,237 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "vcml/protocols/tlm_memory.h"
+
+namespace vcml {
+
+// copies size bytes from src to dest, skipping all bytes whose byte enable is
+// zero; the byte enable pattern repeats every belen bytes, starting at beoff
+static void memcpy_masked(u8* dest, const u8* src, size_t size, const u8* be,
+                          size_t belen, size_t beoff) {
+    beoff %= belen;
+    while (size > 0) {
+        size_t n = min(size, belen - beoff);
+        const u8* mask = be + beoff;
+
+        // keep this loop branch-free so that it gets vectorized
+        for (size_t i = 0; i < n; i++) {
+            u8 m = mask[i] ? 0xff : 0x00;
+            dest[i] = (dest[i] & ~m) | (src[i] & m);
+        }
+
+        dest += n;
+        src += n;
+        size -= n;
+        beoff = 0;
+    }
+}
+
+static unsigned int count_enabled(const u8* be, size_t belen, size_t size) {
+    size_t enabled = 0;
+    for (size_t i = 0; i < belen; i++)
+        enabled += be[i] ? 1 : 0;
+
+    size_t count = (size / belen) * enabled;
+    for (size_t i = 0; i < size % belen; i++)
+        count += be[i] ? 1 : 0;
+
+    return count;
+}
+
+struct snapshot_header {
+    u64 magic;
+    u64 page_size;
+    u64 size;
+    u64 pages;
+};
+
+static const u64 SNAPSHOT_MAGIC = fourcc("vmss");
+
+tlm_response_status tlm_memory::check(const range& addr, tlm_command cmd,
+                                      bool debug) const {
+    if (addr.end >= size())
+        return TLM_ADDRESS_ERROR_RESPONSE;
+
+    if (debug)
+        return TLM_OK_RESPONSE;
+
+    if (cmd == TLM_READ_COMMAND && !is_read_allowed())
+        return TLM_COMMAND_ERROR_RESPONSE;
+
+    if (cmd == TLM_WRITE_COMMAND && !m_discard && !is_write_allowed())
+        return TLM_COMMAND_ERROR_RESPONSE;
+
+    return TLM_OK_RESPONSE;
+}
+
+unsigned int tlm_memory::transport_sg(tlm_generic_payload& tx, sgext& sg,
+                                      bool debug) {
+    unsigned int bytes = 0;
+    tlm_command cmd = tx.get_command();
+    bool discard = m_discard && !debug;
+
+    for (sg.completed = 0; sg.completed < sg.count(); sg.completed++) {
+        const tlm_sg_segment& seg = sg.segments[sg.completed];
+        const range addr = sg.local_range(tx, sg.completed);
+        if (check(addr, cmd, debug) != TLM_OK_RESPONSE)
+            break;
+
+        if (cmd == TLM_READ_COMMAND)
+            memcpy(seg.data, data() + addr.start, seg.size);
+        if (cmd == TLM_WRITE_COMMAND && !discard)
+            memcpy(data() + addr.start, seg.data, seg.size);
+
+        bytes += seg.size;
+    }
+
+    return bytes;
+}
+
+unsigned int tlm_memory::transport(tlm_generic_payload& tx,
+                                   const tlm_sbi& sbi) {
+    u8* ptr = tx.get_data_ptr();
+    unsigned int length = tx.get_data_length();
+    unsigned int width = tx.get_streaming_width();
+    const u8* beptr = tx.get_byte_enable_ptr();
+    unsigned int belen = tx.get_byte_enable_length();
+    tlm_command cmd = tx.get_command();
+
+    sgext* sg = tx.get_extension<sgext>();
+    if (sg != nullptr)
+        sg->completed = 0;
+
+    if (width == 0)
+        width = length;
+
+    if (width > length || length % width) {
+        tx.set_response_status(TLM_BURST_ERROR_RESPONSE);
+        return 0;
+    }
+
+    if (beptr != nullptr && belen == 0) {
+        tx.set_response_status(TLM_BYTE_ENABLE_ERROR_RESPONSE);
+        return 0;
+    }
+
+    const range addr(tx.get_address(), tx.get_address() + width - 1);
+    tlm_response_status rs = check(addr, cmd, sbi.is_debug);
+    if (rs != TLM_OK_RESPONSE || cmd == TLM_IGNORE_COMMAND) {
+        tx.set_response_status(rs);
+        return 0;
+    }
+
+    u8* mem = data() + addr.start;
+    bool discard = m_discard && !sbi.is_debug;
+
+    if (cmd == TLM_READ_COMMAND) {
+        for (unsigned int offset = 0; offset < length; offset += width) {
+            if (beptr)
+                memcpy_masked(ptr + offset, mem, width, beptr, belen, offset);
+            else
+                memcpy(ptr + offset, mem, width);
+        }
+    }
+
+    if (cmd == TLM_WRITE_COMMAND && !discard) {
+        if (beptr) {
+            for (unsigned int offset = 0; offset < length; offset += width)
+                memcpy_masked(mem, ptr + offset, width, beptr, belen, offset);
+        } else {
+            // only the last beat of a streaming write remains visible
+            memcpy(mem, ptr + length - width, width);
+        }
+    }
+
+    tx.set_response_status(TLM_OK_RESPONSE);
+    unsigned int bytes = beptr ? count_enabled(beptr, belen, length) : length;
+
+    if (sg != nullptr)
+        bytes += transport_sg(tx, *sg, sbi.is_debug);
+
+    return bytes;
+}
+
+bool tlm_memory::is_dirty(u64 addr) const {
+    if (!m_tracking || addr >= size())
+        return false;
+
+    u64 page = addr / m_page_size;
+    return (m_dirty[page / 64] >> (page % 64)) & 1;
+}
+
+size_t tlm_memory::count_dirty() const {
+    size_t count = 0;
+    for (u64 word : m_dirty)
+        count += popcnt(word);
+    return count;
+}
+
+size_t tlm_memory::count_pages() const {
+    return m_page_size ? (size() + m_page_size - 1) / m_page_size : 0;
+}
+
+size_t tlm_memory::save_snapshot(ostream& os, bool full) {
+    VCML_ERROR_ON(data() == nullptr, "memory not initialized");
+    VCML_ERROR_ON(!full && !m_tracking, "dirty page tracking disabled");
+
+    vector<u64> pages;
+    for (u64 page = 0; page < count_pages(); page++) {
+        if (full || ((m_dirty[page / 64] >> (page % 64)) & 1))
+            pages.push_back(page);
+    }
+
+    checkpoint();
+
+    snapshot_header header;
+    header.magic = SNAPSHOT_MAGIC;
+    header.page_size = m_page_size;
+    header.size = size();
+    header.pages = pages.size();
+    os.write((const char*)&header, sizeof(header));
+
+    for (u64 page : pages) {
+        u64 offset = page * m_page_size;
+        size_t length = min<u64>(m_page_size, size() - offset);
+        os.write((const char*)&page, sizeof(page));
+        os.write((const char*)data() + offset, length);
+    }
+
+    return pages.size();
+}
+
+bool tlm_memory::load_snapshot(istream& is) {
+    VCML_ERROR_ON(data() == nullptr, "memory not initialized");
+
+    snapshot_header header;
+    if (!is.read((char*)&header, sizeof(header)))
+        return false;
+
+    if (header.magic != SNAPSHOT_MAGIC || header.page_size != m_page_size ||
+        header.size != size()) {
+        return false;
+    }
+
+    for (u64 i = 0; i < header.pages; i++) {
+        u64 page;
+        if (!is.read((char*)&page, sizeof(page)) || page >= count_pages())
+            return false;
+
+        u64 offset = page * m_page_size;
+        size_t length = min<u64>(m_page_size, size() - offset);
+        mark_dirty({ offset, offset + length - 1 });
+        if (!is.read((char*)data() + offset, length))
+            return false;
+    }
+
+    return true;
+}
+
+} // namespace vcml
@@ -14,9 +14,81 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <signal.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
 
 namespace vcml {
 
+static size_t hugetlb_page_size() {
+    static size_t pgsz = []() -> size_t {
+        std::ifstream meminfo("/proc/meminfo");
+        string line;
+        while (std::getline(meminfo, line)) {
+            unsigned long kib = 0;
+            if (sscanf(line.c_str(), "Hugepagesize: %lu kB", &kib) == 1)
+                return kib * KiB;
+        }
+        return 0;
+    }();
+
+    return pgsz;
+}
+
+// memories with dirty page tracking enabled, searched by the fault handler
+static atomic<tlm_memory*> g_tracked[256];
+static struct sigaction g_oldact;
+
+static void handle_write_fault(int sig, siginfo_t* info, void* context) {
+    const u8* addr = (const u8*)info->si_addr;
+    for (auto& slot : g_tracked) {
+        tlm_memory* mem = slot.load(std::memory_order_acquire);
+        if (!mem || addr < mem->data() || addr >= mem->data() + mem->size())
+            continue;
+
+        // unprotects the page, so the write succeeds once we return
+        u64 offset = addr - mem->data();
+        mem->mark_dirty({ offset, offset });
+        return;
+    }
+
+    if ((g_oldact.sa_flags & SA_SIGINFO) && g_oldact.sa_sigaction) {
+        g_oldact.sa_sigaction(sig, info, context);
+        return;
+    }
+
+    if (g_oldact.sa_handler != SIG_DFL && g_oldact.sa_handler != SIG_IGN) {
+        g_oldact.sa_handler(sig);
+        return;
+    }
+
+    // not ours: restore default handling, the access will fault again
+    signal(sig, SIG_DFL);
+}
+
+static void install_fault_handler() {
+    static std::once_flag once;
+    std::call_once(once, []() -> void {
+        struct sigaction newact {};
+        sigemptyset(&newact.sa_mask);
+        newact.sa_sigaction = &handle_write_fault;
+        newact.sa_flags = SA_SIGINFO;
+        VCML_ERROR_ON(sigaction(SIGSEGV, &newact, &g_oldact) < 0,
+                      "failed to install SIGSEGV handler: %s",
+                      strerror(errno));
+    });
+}
+
 int tlm_memory::init_shared(const string& shared, size_t size) {
     VCML_ERROR_ON(is_shared(), "shared memory already initialized");
     m_shared = shared;
@@ -48,7 +120,19 @@ int tlm_memory::init_shared(const string& shared, size_t size) {
 }
 
 tlm_memory::tlm_memory():
-    tlm_dmi(), m_handle(), m_base(), m_size(0), m_discard(false), m_shared() {
+    tlm_dmi(),
+    m_handle(),
+    m_base(),
+    m_size(0),
+    m_discard(false),
+    m_hugepages(false),
+    m_hugetlb(false),
+    m_prefault(false),
+    m_numa_node(-1),
+    m_page_size(0),
+    m_tracking(false),
+    m_dirty(),
+    m_shared() {
 }
 
 tlm_memory::tlm_memory(size_t size): tlm_memory() {
@@ -73,7 +157,21 @@ tlm_memory::tlm_memory(tlm_memory&& other) noexcept:
     m_handle(other.m_handle),
     m_base(other.m_base),
     m_size(other.m_size),
-    m_discard(other.m_discard) {
+    m_discard(other.m_discard),
+    m_hugepages(other.m_hugepages),
+    m_hugetlb(other.m_hugetlb),
+    m_prefault(other.m_prefault),
+    m_numa_node(other.m_numa_node),
+    m_page_size(other.m_page_size),
+    m_tracking(other.m_tracking),
+    m_dirty(std::move(other.m_dirty)) {
+    for (auto& slot : g_tracked) {
+        tlm_memory* expected = &other;
+        if (slot.compare_exchange_strong(expected, this))
+            break;
+    }
+
+    other.m_tracking = false;
     other.m_handle = nullptr;
     other.m_base = nullptr;
     other.m_size = 0;
@@ -84,9 +182,51 @@ tlm_memory::~tlm_memory() {
     free();
 }
 
+void tlm_memory::init_pages(u8* ptr, size_t size) {
+#ifdef MADV_HUGEPAGE
+    if (m_hugepages && !is_hugetlb())
+        m_hugepages = madvise(m_base, m_size, MADV_HUGEPAGE) == 0;
+    else
+        m_hugepages = false;
+#else
+    m_hugepages = false;
+#endif
+
+#ifdef SYS_mbind
+    if (m_numa_node >= 0) {
+        unsigned long mask = 0;
+        const unsigned long maxnode = sizeof(mask) * 8;
+        VCML_ERROR_ON((unsigned long)m_numa_node >= maxnode,
+                      "NUMA node %d out of range", m_numa_node);
+        mask = 1ul << m_numa_node;
+        // kernel expects maxnode to be one past the number of mask bits
+        long res = syscall(SYS_mbind, m_base, m_size, MPOL_BIND, &mask,
+                           maxnode + 1, 0);
+        VCML_ERROR_ON(res, "cannot bind memory to NUMA node %d: %s",
+                      m_numa_node, strerror(errno));
+    }
+#endif
+
+    if (!m_prefault)
+        return;
+
+    // fault in all pages now, fall back to touching them on older kernels
+    if (madvise(ptr, size, MADV_POPULATE_WRITE) == 0)
+        return;
+
+    for (size_t offset = 0; offset < size; offset += m_page_size) {
+        volatile u8* page = ptr + offset;
+        *page = *page;
+    }
+}
+
 void tlm_memory::init(const string& shared, size_t size, alignment al) {
     VCML_ERROR_ON(m_size, "memory already initialized");
 
+    // transparent huge pages only get used for 2M aligned regions
+    if (m_hugepages && al < VCML_ALIGN_2M)
+        al = VCML_ALIGN_2M;
+
     // mmap automatically aligns up to host page size, for larger alignments
     // we reserve extra space to include an aligned start address plus size
     u64 extra = (al > host_page_alignment()) ? (1ull << al) - 1 : 0;
@@ -103,11 +243,33 @@ void tlm_memory::init(const string& shared, size_t size, alignment al) {
     else
         flags |= MAP_PRIVATE | MAP_ANON;
 
-    m_base = mmap(0, m_size, perms, flags, fd, 0);
+    m_base = MAP_FAILED;
+    m_page_size = mwr::get_page_size();
+
+#ifdef MAP_HUGETLB
+    // no MAP_NORESERVE here: we want mmap to fail if the huge page pool is
+    // too small instead of getting SIGBUS when touching the memory later on
+    size_t hpsz = hugetlb_page_size();
+    if (m_hugetlb && !is_shared() && hpsz > 0) {
+        size_t hpsize = (m_size + hpsz - 1) & ~(hpsz - 1);
+        int hpflags = MAP_PRIVATE | MAP_ANON | MAP_HUGETLB;
+        m_base = mmap(0, hpsize, perms, hpflags, -1, 0);
+        if (m_base != MAP_FAILED) {
+            m_size = hpsize;
+            m_page_size = hpsz;
+        }
+    }
+#endif
+
+    if (m_base == MAP_FAILED)
+        m_base = mmap(0, m_size, perms, flags, fd, 0);
+
     VCML_ERROR_ON(m_base == MAP_FAILED, "mmap failed: %s", strerror(errno));
     u8* ptr = (u8*)(((u64)m_base + extra) & ~extra);
     VCML_ERROR_ON(!is_aligned(ptr, al), "memory alignment failed");
 
+    init_pages(ptr, size);
+
     tlm_dmi::init();
     set_dmi_ptr(ptr);
     set_start_address(0);
@@ -116,6 +278,8 @@ void tlm_memory::init(const string& shared, size_t size, alignment al) {
 }
 
 void tlm_memory::free() {
+    track_dirty(false);
+
     if (m_base != nullptr) {
         int ret = munmap(m_base, m_size);
         VCML_ERROR_ON(ret, "munmap failed: %d", ret);
@@ -131,6 +295,111 @@ void tlm_memory::free() {
     tlm_dmi::init();
 }
 
+bool tlm_memory::map_file(const string& filename, u64 offset) {
+    // cannot overlay shared or hugetlb memory with private file mappings
+    if (data() == nullptr || is_shared() || is_hugetlb())
+        return false;
+
+    if (offset % m_page_size)
+        return false;
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat stat {};
+    if (fstat(fd, &stat) || stat.st_size <= 0 ||
+        offset + stat.st_size > size()) {
+        close(fd);
+        return false;
+    }
+
+    // pages get read lazily from the file and copied once they are written;
+    // the remainder of the last page beyond the end of the file reads zero
+    size_t length = stat.st_size;
+    u8* addr = data() + offset;
+    int perms = PROT_READ | PROT_WRITE;
+    int flags = MAP_PRIVATE | MAP_FIXED;
+    void* ptr = mmap(addr, length, perms, flags, fd, 0);
+    close(fd);
+
+    if (ptr == addr) {
+        mark_dirty({ offset, offset + length - 1 });
+        return true;
+    }
+
+    // mmap might have already dropped the old mapping, so put it back
+    flags = MAP_PRIVATE | MAP_ANON | MAP_FIXED | MAP_NORESERVE;
+    ptr = mmap(addr, length, perms, flags, -1, 0);
+    VCML_ERROR_ON(ptr != addr, "mmap failed: %s", strerror(errno));
+    mark_dirty({ offset, offset + length - 1 });
+    return false;
+}
+
+bool tlm_memory::track_dirty(bool track) {
+    if (track == m_tracking)
+        return true;
+
+    if (!track) {
+        for (auto& slot : g_tracked) {
+            tlm_memory* expected = this;
+            if (slot.compare_exchange_strong(expected, nullptr))
+                break;
+        }
+
+        int res = mprotect(data(), count_pages() * m_page_size,
+                           PROT_READ | PROT_WRITE);
+        VCML_ERROR_ON(res, "mprotect failed: %s", strerror(errno));
+        m_tracking = false;
+        m_dirty.clear();
+        return true;
+    }
+
+    // writes from other processes to shared memory do not fault here
+    if (data() == nullptr || is_shared())
+        return false;
+
+    install_fault_handler();
+
+    m_dirty.assign((count_pages() + 63) / 64, 0);
+    for (auto& slot : g_tracked) {
+        tlm_memory* expected = nullptr;
+        if (slot.compare_exchange_strong(expected, this)) {
+            m_tracking = true;
+            checkpoint();
+            return true;
+        }
+    }
+
+    m_dirty.clear();
+    return false;
+}
+
+void tlm_memory::mark_dirty(const range& addr) {
+    if (!m_tracking || addr.start > addr.end || addr.start >= size())
+        return;
+
+    u64 first = addr.start / m_page_size;
+    u64 last = min<u64>(addr.end, size() - 1) / m_page_size;
+    for (u64 page = first; page <= last; page++) {
+        __atomic_fetch_or(&m_dirty[page / 64], 1ull << (page % 64),
+                          __ATOMIC_RELAXED);
+    }
+
+    // this also runs inside the fault handler, so no reporting here
+    size_t length = (last - first + 1) * m_page_size;
+    mprotect(data() + first * m_page_size, length, PROT_READ | PROT_WRITE);
+}
+
+void tlm_memory::checkpoint() {
+    if (!m_tracking)
+        return;
+
+    int res = mprotect(data(), count_pages() * m_page_size, PROT_READ);
+    VCML_ERROR_ON(res, "mprotect failed: %s", strerror(errno));
+    std::fill(m_dirty.begin(), m_dirty.end(), 0);
+}
+
 tlm_response_status tlm_memory::fill(u8 data, bool debug) {
     if (!is_write_allowed() && !debug)
         return m_discard ? TLM_OK_RESPONSE : TLM_COMMAND_ERROR_RESPONSE;
@@ -168,16 +437,4 @@ tlm_response_status tlm_memory::write(const range& addr, const void* src,
     return TLM_OK_RESPONSE;
 }
 
-void tlm_memory::transport(tlm_generic_payload& tx, const tlm_sbi& sbi) {
-    tlm_response_status res = TLM_OK_RESPONSE;
-    range addr(tx);
-
-    if (tx.is_read())
-        res = read(addr, tx.get_data_ptr(), sbi.is_debug);
-    if (tx.is_write())
-        res = write(addr, tx.get_data_ptr(), sbi.is_debug);
-
-    tx.set_response_status(res);
-}
-
 } // namespace vcml
@@ -42,12 +42,26 @@ int tlm_memory::init_shared(const string& shared, size_t size) {
     return 0;
 }
 
+void tlm_memory::init_pages(u8* ptr, size_t size) {
+    // large pages require SeLockMemoryPrivilege, NUMA binding is not
+    // supported; memory is committed upfront by VirtualAlloc anyway
+    m_hugepages = false;
+    m_page_size = mwr::get_page_size();
+}
+
 tlm_memory::tlm_memory():
     tlm_dmi(),
     m_handle(nullptr),
     m_base(nullptr),
     m_size(0),
     m_discard(false),
+    m_hugepages(false),
+    m_hugetlb(false),
+    m_prefault(false),
+    m_numa_node(-1),
+    m_page_size(0),
+    m_tracking(false),
+    m_dirty(),
     m_shared() {
 }
 
@@ -73,7 +87,14 @@ tlm_memory::tlm_memory(tlm_memory&& other) noexcept:
     m_handle(other.m_handle),
     m_base(other.m_base),
     m_size(other.m_size),
-    m_discard(other.m_discard) {
+    m_discard(other.m_discard),
+    m_hugepages(other.m_hugepages),
+    m_hugetlb(other.m_hugetlb),
+    m_prefault(other.m_prefault),
+    m_numa_node(other.m_numa_node),
+    m_page_size(other.m_page_size),
+    m_tracking(false),
+    m_dirty() {
     other.m_handle = INVALID_HANDLE_VALUE;
     other.m_base = nullptr;
     other.m_size = 0;
@@ -102,6 +123,8 @@ void tlm_memory::init(const string& shared, size_t size, alignment al) {
     u8* ptr = (u8*)(((u64)m_base + extra) & ~extra);
     VCML_ERROR_ON(!is_aligned(ptr, al), "memory alignment failed");
 
+    init_pages(ptr, size);
+
     tlm_dmi::init();
     set_dmi_ptr(ptr);
     set_start_address(0);
@@ -128,6 +151,22 @@ void tlm_memory::free() {
     tlm_dmi::init();
 }
 
+bool tlm_memory::map_file(const string& filename, u64 offset) {
+    return false; // not supported, image needs to be copied instead
+}
+
+bool tlm_memory::track_dirty(bool track) {
+    return !track; // not supported, only full snapshots can be taken
+}
+
+void tlm_memory::mark_dirty(const range& addr) {
+    // nothing to do
+}
+
+void tlm_memory::checkpoint() {
+    // nothing to do
+}
+
 tlm_response_status tlm_memory::fill(u8 data, bool debug) {
     if (!is_write_allowed() && !debug)
         return m_discard ? TLM_OK_RESPONSE : TLM_COMMAND_ERROR_RESPONSE;
@@ -165,16 +204,4 @@ tlm_response_status tlm_memory::write(const range& addr, const void* src,
     return TLM_OK_RESPONSE;
 }
 
-void tlm_memory::transport(tlm_generic_payload& tx, const tlm_sbi& sbi) {
-    tlm_response_status res = TLM_OK_RESPONSE;
-    range addr(tx);
-
-    if (tx.is_read())
-        res = read(addr, tx.get_data_ptr(), sbi.is_debug);
-    if (tx.is_write())
-        res = write(addr, tx.get_data_ptr(), sbi.is_debug);
-
-    tx.set_response_status(res);
-}
-
 } // namespace vcml
@@ -0,0 +1,33 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "vcml/protocols/tlm_mm.h"
+
+namespace vcml {
+
+tlm_mm::tlm_mm(): m_payloads(), m_free() {
+    // nothing to do
+}
+
+tlm_mm::~tlm_mm() {
+    for (tlm_generic_payload* tx : m_payloads)
+        delete tx;
+}
+
+void tlm_mm::free(tlm_generic_payload* tx) {
+    tx->reset(); // drops auto extensions, but keeps our sbiext
+    tx->set_data_ptr(nullptr);
+    tx->set_byte_enable_ptr(nullptr);
+    tx->set_byte_enable_length(0);
+    tx->set_dmi_allowed(false);
+    m_free.push_back(tx);
+}
+
+} // namespace vcml
@@ -12,38 +12,298 @@
 
 namespace vcml {
 
+void tlm_probe_stats::reset() {
+    memset(reads, 0, sizeof(reads));
+    memset(writes, 0, sizeof(writes));
+    ignores = 0;
+    num_b_transport = 0;
+    num_nb_transport = 0;
+    num_transport_dbg = 0;
+    num_dmi_requests = 0;
+    num_dmi_granted = 0;
+    num_dmi_invalidations = 0;
+    num_errors = 0;
+    memset(errors, 0, sizeof(errors));
+    memset(delays, 0, sizeof(delays));
+    total_delay = SC_ZERO_TIME;
+    max_delay = SC_ZERO_TIME;
+    host_time_ns = 0;
+}
+
+u64 tlm_probe_stats::num_reads() const {
+    u64 count = 0;
+    for (u64 n : reads)
+        count += n;
+    return count;
+}
+
+u64 tlm_probe_stats::num_writes() const {
+    u64 count = 0;
+    for (u64 n : writes)
+        count += n;
+    return count;
+}
+
+void tlm_probe_stats::count(const tlm_generic_payload& tx) {
+    size_t cls = size_class(tx.get_data_length());
+    switch (tx.get_command()) {
+    case TLM_READ_COMMAND:
+        reads[cls]++;
+        break;
+    case TLM_WRITE_COMMAND:
+        writes[cls]++;
+        break;
+    default:
+        ignores++;
+        break;
+    }
+
+    tlm_response_status rs = tx.get_response_status();
+    if (rs != TLM_OK_RESPONSE && rs >= TLM_BYTE_ENABLE_ERROR_RESPONSE) {
+        errors[1 - rs]++;
+        num_errors++;
+    }
+}
+
+void tlm_probe_stats::count_delay(const sc_time& delay) {
+    delays[delay_class(delay)]++;
+    total_delay += delay;
+    if (delay > max_delay)
+        max_delay = delay;
+}
+
+size_t tlm_probe_stats::size_class(unsigned int size) {
+    size_t cls = 0;
+    while (cls < NUM_SIZES - 1 && (1u << cls) < size)
+        cls++;
+    return cls;
+}
+
+const char* tlm_probe_stats::size_class_str(size_t cls) {
+    static const char* const names[NUM_SIZES] = {
+        "1", "2", "4", "8", "16", "32", "64", "more",
+    };
+
+    return cls < NUM_SIZES ? names[cls] : "unknown";
+}
+
+size_t tlm_probe_stats::delay_class(const sc_time& delay) {
+    u64 ns = time_to_ns(delay);
+    size_t cls = 0;
+    while (cls < NUM_DELAYS - 1 && ns > 0) {
+        ns >>= 1;
+        cls++;
+    }
+
+    return cls;
+}
+
+bool tlm_probe::cmd_stats(const vector<string>& args, ostream& os) {
+    print_stats(os);
+    return true;
+}
+
+bool tlm_probe::cmd_reset_stats(const vector<string>& args, ostream& os) {
+    reset_stats();
+    os << "statistics reset";
+    return true;
+}
+
 void tlm_probe::b_transport(tlm_generic_payload& tx, sc_time& t) {
+    sc_time start = t;
+    u64 host = mwr::timestamp_ns();
     out->b_transport(tx, t);
+    m_stats.host_time_ns += mwr::timestamp_ns() - host;
+
+    m_stats.num_b_transport++;
+    m_stats.count(tx);
+    m_stats.count_delay(t > start ? t - start : SC_ZERO_TIME);
 }
 
 unsigned int tlm_probe::transport_dbg(tlm_generic_payload& tx) {
+    m_stats.num_transport_dbg++;
     return out->transport_dbg(tx);
 }
 
 bool tlm_probe::get_direct_mem_ptr(tlm_generic_payload& tx, tlm_dmi& dmi) {
-    return out->get_direct_mem_ptr(tx, dmi);
+    m_stats.num_dmi_requests++;
+    bool granted = out->get_direct_mem_ptr(tx, dmi);
+    if (granted)
+        m_stats.num_dmi_granted++;
+    return granted;
 }
 
 void tlm_probe::invalidate_direct_mem_ptr(u64 start, u64 end) {
+    m_stats.num_dmi_invalidations++;
     return in->invalidate_direct_mem_ptr(start, end);
 }
 
 tlm::tlm_sync_enum tlm_probe::nb_transport_fw(tlm_generic_payload& tx,
                                               tlm::tlm_phase& phase,
                                               sc_time& t) {
+    if (phase == tlm::BEGIN_REQ)
+        m_stats.num_nb_transport++;
     return out->nb_transport_fw(tx, phase, t);
 }
 
 tlm::tlm_sync_enum tlm_probe::nb_transport_bw(tlm_generic_payload& trans,
                                               tlm::tlm_phase& phase,
                                               sc_time& t) {
+    if (phase == tlm::BEGIN_RESP)
+        m_stats.count(trans);
     return in->nb_transport_bw(trans, phase, t);
 }
 
+void tlm_probe::end_of_simulation() {
+    module::end_of_simulation();
+
+    const string& filename = stats_file;
+    if (filename.empty())
+        return;
+
+    ofstream file(filename.c_str(), std::ios::trunc);
+    if (!file.is_open()) {
+        log_warn("cannot open statistics file '%s'", filename.c_str());
+        return;
+    }
+
+    if (ends_with(filename, ".json"))
+        write_json(file);
+    else
+        write_csv(file);
+}
+
+void tlm_probe::print_stats(ostream& os) const {
+    const tlm_probe_stats& s = m_stats;
+    os << "transactions: " << s.num_b_transport << " b_transport, "
+       << s.num_nb_transport << " nb_transport, " << s.num_transport_dbg
+       << " debug";
+
+    os << "\nreads: " << s.num_reads();
+    for (size_t i = 0; i < s.NUM_SIZES; i++) {
+        if (s.reads[i])
+            os << ", " << s.reads[i] << "x" << s.size_class_str(i);
+    }
+
+    os << "\nwrites: " << s.num_writes();
+    for (size_t i = 0; i < s.NUM_SIZES; i++) {
+        if (s.writes[i])
+            os << ", " << s.writes[i] << "x" << s.size_class_str(i);
+    }
+
+    os << "\ndmi: " << s.num_dmi_granted << " of " << s.num_dmi_requests
+       << " requests granted, " << s.num_dmi_invalidations
+       << " invalidations";
+
+    os << "\nerrors: " << s.num_errors;
+    for (size_t i = 1; i < 7; i++) {
+        if (s.errors[i]) {
+            os << ", " << s.errors[i] << "x"
+               << tlm_response_to_str((tlm_response_status)(1 - i));
+        }
+    }
+
+    os << "\ndelay: total " << s.total_delay << ", max " << s.max_delay;
+    for (size_t i = 0; i < s.NUM_DELAYS; i++) {
+        if (s.delays[i])
+            os << "\n  < " << (1ull << i) << "ns: " << s.delays[i];
+    }
+
+    os << "\nhost time: " << s.host_time_ns / 1000 << "us";
+}
+
+void tlm_probe::write_csv(ostream& os) const {
+    const tlm_probe_stats& s = m_stats;
+    const char* nm = name();
+    os << "probe,metric,value" << std::endl;
+    os << nm << ",b_transport," << s.num_b_transport << std::endl;
+    os << nm << ",nb_transport," << s.num_nb_transport << std::endl;
+    os << nm << ",transport_dbg," << s.num_transport_dbg << std::endl;
+    for (size_t i = 0; i < s.NUM_SIZES; i++) {
+        os << nm << ",reads_" << s.size_class_str(i) << "," << s.reads[i]
+           << std::endl;
+    }
+    for (size_t i = 0; i < s.NUM_SIZES; i++) {
+        os << nm << ",writes_" << s.size_class_str(i) << "," << s.writes[i]
+           << std::endl;
+    }
+    os << nm << ",ignores," << s.ignores << std::endl;
+    os << nm << ",dmi_requests," << s.num_dmi_requests << std::endl;
+    os << nm << ",dmi_granted," << s.num_dmi_granted << std::endl;
+    os << nm << ",dmi_invalidations," << s.num_dmi_invalidations
+       << std::endl;
+    os << nm << ",errors," << s.num_errors << std::endl;
+    for (size_t i = 1; i < 7; i++) {
+        os << nm << "," << tlm_response_to_str((tlm_response_status)(1 - i))
+           << "," << s.errors[i] << std::endl;
+    }
+    for (size_t i = 0; i < s.NUM_DELAYS; i++) {
+        os << nm << ",delay_lt_" << (1ull << i) << "ns," << s.delays[i]
+           << std::endl;
+    }
+    os << nm << ",delay_total_ns," << time_to_ns(s.total_delay) << std::endl;
+    os << nm << ",delay_max_ns," << time_to_ns(s.max_delay) << std::endl;
+    os << nm << ",host_time_ns," << s.host_time_ns << std::endl;
+}
+
+template <typename T, size_t N>
+static void write_json_array(ostream& os, const T (&values)[N]) {
+    os << "[";
+    for (size_t i = 0; i < N; i++)
+        os << (i ? "," : "") << values[i];
+    os << "]," << std::endl;
+}
+
+void tlm_probe::write_json(ostream& os) const {
+    const tlm_probe_stats& s = m_stats;
+    os << "{" << std::endl;
+    os << "  \"probe\": \"" << name() << "\"," << std::endl;
+    os << "  \"b_transport\": " << s.num_b_transport << "," << std::endl;
+    os << "  \"nb_transport\": " << s.num_nb_transport << "," << std::endl;
+    os << "  \"transport_dbg\": " << s.num_transport_dbg << "," << std::endl;
+    os << "  \"size_classes\": [";
+    for (size_t i = 0; i < s.NUM_SIZES; i++)
+        os << (i ? "," : "") << "\"" << s.size_class_str(i) << "\"";
+    os << "]," << std::endl;
+    os << "  \"reads\": ";
+    write_json_array(os, s.reads);
+    os << "  \"writes\": ";
+    write_json_array(os, s.writes);
+    os << "  \"ignores\": " << s.ignores << "," << std::endl;
+    os << "  \"dmi_requests\": " << s.num_dmi_requests << "," << std::endl;
+    os << "  \"dmi_granted\": " << s.num_dmi_granted << "," << std::endl;
+    os << "  \"dmi_invalidations\": " << s.num_dmi_invalidations << ","
+       << std::endl;
+    os << "  \"errors\": {";
+    for (size_t i = 1; i < 7; i++) {
+        os << (i > 1 ? "," : "") << "\""
+           << tlm_response_to_str((tlm_response_status)(1 - i))
+           << "\": " << s.errors[i];
+    }
+    os << "}," << std::endl;
+    os << "  \"delay_histogram_ns\": ";
+    write_json_array(os, s.delays);
+    os << "  \"delay_total_ns\": " << time_to_ns(s.total_delay) << ","
+       << std::endl;
+    os << "  \"delay_max_ns\": " << time_to_ns(s.max_delay) << ","
+       << std::endl;
+    os << "  \"host_time_ns\": " << s.host_time_ns << std::endl;
+    os << "}" << std::endl;
+}
+
 tlm_probe::tlm_probe(const sc_module_name& nm):
-    module(nm), in("in"), out("out") {
+    module(nm),
+    m_stats(),
+    stats_file("stats_file", ""),
+    in("in"),
+    out("out") {
     in.bind(*this);
     out.bind(*this);
+
+    register_command("stats", 0, &tlm_probe::cmd_stats,
+                     "print transaction statistics");
+    register_command("reset_stats", 0, &tlm_probe::cmd_reset_stats,
+                     "reset transaction statistics");
 }
 
 } // namespace vcml
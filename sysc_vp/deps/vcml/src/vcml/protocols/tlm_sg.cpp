@@ -0,0 +1,28 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "vcml/protocols/tlm_sg.h"
+
+namespace vcml {
+
+tlm_extension_base* sgext::clone() const {
+    return new sgext(*this);
+}
+
+void sgext::copy_from(const tlm_extension_base& ext) {
+    VCML_ERROR_ON(typeid(this) != typeid(ext), "cannot copy extension");
+    const sgext& other = (const sgext&)ext;
+    base = other.base;
+    limit = other.limit;
+    completed = other.completed;
+    segments = other.segments;
+}
+
+} // namespace vcml
@@ -27,8 +27,7 @@ tlm_initiator_socket::tlm_initiator_socket(const char* nm,
                                            address_space space):
     simple_initiator_socket<tlm_initiator_socket>(nm),
     hierarchy_element(),
-    m_tx(),
-    m_txd(),
+    m_mm(),
     m_sbi(SBI_NONE),
     m_dmi_cache(),
     m_stub(nullptr),
@@ -49,9 +48,6 @@ tlm_initiator_socket::tlm_initiator_socket(const char* nm,
 
     register_invalidate_direct_mem_ptr(
         this, &tlm_initiator_socket::invalidate_direct_mem_ptr_int);
-
-    m_tx.set_extension(new sbiext());
-    m_txd.set_extension(new sbiext());
 }
 
 tlm_initiator_socket::~tlm_initiator_socket() {
@@ -71,10 +67,12 @@ u8* tlm_initiator_socket::lookup_dmi_ptr(const range& mem, vcml_access rw) {
     if (dmi_cache().lookup(mem, rw, dmi))
         return dmi_get_ptr(dmi, mem.start);
 
-    tlm_generic_payload tx;
+    tlm_generic_payload* tx = m_mm.allocate();
     tlm_command cmd = tlm_command_from_access(rw);
-    tx_setup(tx, cmd, mem.start, nullptr, mem.length());
-    if (!(*this)->get_direct_mem_ptr(tx, dmi))
+    tx_setup(*tx, cmd, mem.start, nullptr, mem.length());
+    bool granted = (*this)->get_direct_mem_ptr(*tx, dmi);
+    tx->release();
+    if (!granted)
         return nullptr;
 
     map_dmi(dmi);
@@ -129,8 +127,10 @@ unsigned int tlm_initiator_socket::send(tlm_generic_payload& tx,
         if (!is_thread())
             VCML_ERROR("non-debug TLM access outside SC_THREAD forbidden");
 
-        if (info.is_sync || m_host->needs_sync())
-            m_host->sync();
+        if (info.is_sync)
+            m_host->sync(TLM_SYNC_TRANSACTION);
+        else if (m_host->needs_sync())
+            m_host->sync(TLM_SYNC_QUANTUM);
 
         sc_time& offset = m_host->local_time();
         sc_time local = sc_time_stamp() + offset;
@@ -140,8 +140,10 @@ unsigned int tlm_initiator_socket::send(tlm_generic_payload& tx,
         sc_time now = sc_time_stamp() + offset;
         VCML_ERROR_ON(now < local, "b_transport time went backwards");
 
-        if (info.is_sync || m_host->needs_sync())
-            m_host->sync();
+        if (info.is_sync)
+            m_host->sync(TLM_SYNC_TRANSACTION);
+        else if (m_host->needs_sync())
+            m_host->sync(TLM_SYNC_QUANTUM);
         bytes = tx.is_response_ok() ? tx.get_data_length() : 0;
     }
 
@@ -177,7 +179,7 @@ tlm_response_status tlm_initiator_socket::access_dmi(tlm_command cmd, u64 addr,
         return TLM_INCOMPLETE_RESPONSE;
 
     if (info.is_sync && !info.is_debug)
-        m_host->sync();
+        m_host->sync(TLM_SYNC_TRANSACTION);
 
     sc_time latency = SC_ZERO_TIME;
     if (cmd == TLM_READ_COMMAND) {
@@ -191,7 +193,7 @@ tlm_response_status tlm_initiator_socket::access_dmi(tlm_command cmd, u64 addr,
     if (!info.is_debug) {
         m_host->local_time() += latency;
         if (info.is_sync)
-            m_host->sync();
+            m_host->sync(TLM_SYNC_TRANSACTION);
     }
 
     return TLM_OK_RESPONSE;
@@ -214,13 +216,16 @@ tlm_response_status tlm_initiator_socket::access(tlm_command cmd, u64 addr,
         }
     }
 
-    // if DMI was not successful, send a regular transaction
-    auto& tx = info.is_debug ? m_txd : m_tx;
-    tx_setup(tx, cmd, addr, data, size);
-    size = send(tx, info);
+    // if DMI was not successful, send a regular transaction; payloads come
+    // from the pool, so that accesses from concurrent threads do not clash
+    tlm_generic_payload* tx = m_mm.allocate();
+    tx_setup(*tx, cmd, addr, data, size);
+    size = send(*tx, info);
 
     // transport_dbg does not always change response status
-    tlm_response_status rs = tx.get_response_status();
+    tlm_response_status rs = tx->get_response_status();
+    tx->release();
+
     if (rs == TLM_INCOMPLETE_RESPONSE && info.is_debug)
         rs = TLM_OK_RESPONSE;
 
@@ -233,6 +238,50 @@ tlm_response_status tlm_initiator_socket::access(tlm_command cmd, u64 addr,
     return rs;
 }
 
+tlm_response_status tlm_initiator_socket::access_sg(
+    tlm_command cmd, const vector<tlm_sg_segment>& segments,
+    const tlm_sbi& info) {
+    // serve as many leading segments as possible via DMI
+    size_t first = 0;
+    while (first < segments.size() && allow_dmi) {
+        const tlm_sg_segment& seg = segments[first];
+        if (!success(access_dmi(cmd, seg.addr, seg.data, seg.size, info)))
+            break;
+        first++;
+    }
+
+    if (first == segments.size())
+        return TLM_OK_RESPONSE;
+
+    // send the remaining segments as extension of a single transaction
+    const tlm_sg_segment& head = segments[first];
+    vector<tlm_sg_segment> tail(segments.begin() + first + 1, segments.end());
+    sgext ext(head.addr, tail);
+
+    tlm_generic_payload* tx = m_mm.allocate();
+    tx_setup(*tx, cmd, head.addr, head.data, head.size);
+    tx->set_extension(&ext);
+    send(*tx, info);
+    tx->clear_extension(&ext);
+
+    tlm_response_status rs = tx->get_response_status();
+    tx->release();
+    if (rs == TLM_INCOMPLETE_RESPONSE && info.is_debug)
+        rs = TLM_OK_RESPONSE;
+    if (failed(rs))
+        return rs;
+
+    // targets without scatter-gather support only complete the payload
+    for (size_t i = ext.completed; i < tail.size(); i++) {
+        const tlm_sg_segment& seg = tail[i];
+        rs = access(cmd, seg.addr, seg.data, seg.size, info);
+        if (failed(rs))
+            return rs;
+    }
+
+    return rs;
+}
+
 void tlm_initiator_socket::stub(tlm_response_status r) {
     VCML_ERROR_ON(m_stub, "socket %s already stubbed", name());
     auto guard = get_hierarchy_scope();
@@ -37,6 +37,19 @@ public:
         });
     }
 
+    void post(vector<int>& jobs) {
+        for (int i = 0; i < 100; i++) {
+            sc_post([&jobs, i]() -> void { jobs.push_back(i); });
+            if (i % 10 == 9) {
+                sc_sync([&jobs, i]() -> void {
+                    EXPECT_EQ(jobs.size(), i + 1);
+                });
+            }
+        }
+
+        sc_post([&jobs]() -> void { EXPECT_EQ(jobs.size(), 100); });
+    }
+
     virtual void run_test() override {
         EXPECT_FALSE(success);
         EXPECT_TRUE(thctl_is_sysc_thread());
@@ -49,6 +62,14 @@ public:
 
         EXPECT_TRUE(success);
         EXPECT_EQ(sc_time_stamp(), 2 * dura);
+
+        vector<int> jobs;
+        sc_async([&]() -> void { post(jobs); });
+        ASSERT_EQ(jobs.size(), 100);
+        for (int i = 0; i < 100; i++)
+            EXPECT_EQ(jobs[i], i);
+
+        sc_join_async();
     }
 };
 
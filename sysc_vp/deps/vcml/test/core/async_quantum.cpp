@@ -0,0 +1,70 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "testing.h"
+#include "vcml/core/systemc.h"
+
+class async_quantum_test : public test_base
+{
+public:
+    const sc_time quantum;
+    vector<std::pair<int, sc_time>> syncs;
+    bool done;
+
+    async_quantum_test(const sc_module_name& nm):
+        test_base(nm), quantum(1200, SC_NS), syncs(), done(false) {
+        tlm::tlm_global_quantum::instance().set(quantum);
+        sc_async_set_deterministic();
+        SC_HAS_PROCESS(async_quantum_test);
+        SC_THREAD(second);
+    }
+
+    void work(int id, const sc_time& step) {
+        sc_time local = SC_ZERO_TIME;
+        for (int i = 0; i < 20; i++) {
+            sc_progress(step);
+            local += step;
+
+            sc_async_wait_quantum(quantum);
+            EXPECT_LT(async_time_offset(), quantum);
+
+            if (i % 5 == 4) {
+                sc_sync([&]() -> void {
+                    EXPECT_EQ(sc_time_stamp(), local) << "sync " << id;
+                    syncs.push_back({ id, sc_time_stamp() });
+                });
+            }
+        }
+    }
+
+    void second() {
+        wait(SC_ZERO_TIME);
+        sc_async([&]() -> void { work(1, sc_time(400, SC_NS)); });
+        done = true;
+    }
+
+    virtual void run_test() override {
+        EXPECT_TRUE(sc_async_is_deterministic());
+        sc_async([&]() -> void { work(0, sc_time(300, SC_NS)); });
+        while (!done)
+            wait(quantum);
+
+        ASSERT_EQ(syncs.size(), 8);
+        for (size_t i = 1; i < syncs.size(); i++)
+            EXPECT_LE(syncs[i - 1].second, syncs[i].second);
+
+        sc_join_async();
+    }
+};
+
+TEST(async, quantum) {
+    async_quantum_test test("async");
+    sc_core::sc_start();
+}
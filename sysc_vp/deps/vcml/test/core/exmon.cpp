@@ -114,3 +114,55 @@ TEST(tlm_exmon, dmi) {
     EXPECT_EQ(dmi.get_end_address(), -1);
     EXPECT_EQ(dmi.get_dmi_ptr(), (unsigned char*)400);
 }
+
+TEST(tlm_exmon, index) {
+    vcml::tlm_exmon mon;
+
+    // one reservation per cpu, spread over different granules
+    for (int cpu = 0; cpu < 64; cpu++)
+        mon.add_lock(cpu, { cpu * 0x100u, cpu * 0x100u + 7 });
+    EXPECT_EQ(mon.get_locks().size(), 64);
+
+    // replacing the lock of a cpu must drop the old one from the index
+    mon.add_lock(3, { 0x10000, 0x10007 });
+    EXPECT_EQ(mon.get_locks().size(), 64);
+    EXPECT_FALSE(mon.has_lock(3, { 0x300, 0x307 }));
+    EXPECT_TRUE(mon.has_lock(3, { 0x10000, 0x10003 }));
+
+    mon.break_locks({ 0x300, 0x3ff });
+    EXPECT_EQ(mon.get_locks().size(), 64);
+
+    // same granule, but no overlap
+    mon.break_locks({ 0x208, 0x20f });
+    EXPECT_TRUE(mon.has_lock(2, { 0x200, 0x207 }));
+
+    mon.break_locks({ 0x204, 0x204 });
+    EXPECT_FALSE(mon.has_lock(2, { 0x200, 0x207 }));
+    EXPECT_EQ(mon.get_locks().size(), 63);
+
+    // large ranges are checked against all locks
+    mon.break_locks({ 0x0, 0x1000 });
+    ASSERT_EQ(mon.get_locks().size(), 48);
+
+    // locks too large for the index
+    mon.add_lock(100, { 0x100000, 0x1fffff });
+    mon.break_locks({ 0x180000, 0x180003 });
+    EXPECT_FALSE(mon.has_lock(100, { 0x100000, 0x100003 }));
+    EXPECT_EQ(mon.get_locks().size(), 48);
+
+    tlm::tlm_generic_payload tx;
+    tx.set_address(0x2000);
+    tx.set_data_length(4);
+    tx.set_write();
+    tx.set_dmi_allowed(true);
+    EXPECT_TRUE(mon.update(tx));
+    EXPECT_FALSE(tx.is_dmi_allowed());
+    EXPECT_FALSE(mon.has_lock(32, { 0x2000, 0x2003 }));
+    EXPECT_EQ(mon.get_locks().size(), 47);
+
+    tx.set_address(0x2008);
+    tx.set_dmi_allowed(true);
+    EXPECT_TRUE(mon.update(tx));
+    EXPECT_TRUE(tx.is_dmi_allowed());
+    EXPECT_EQ(mon.get_locks().size(), 47);
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "testing.h"
+
+TEST(histogram, buckets) {
+    const u64 values[] = {
+        0, 1, 7, 8, 9, 15, 16, 17, 1000, 12345678, 1ull << 40, ~0ull,
+    };
+
+    for (u64 val : values) {
+        size_t idx = histogram::bucket_of(val);
+        ASSERT_LT(idx, histogram::NUM_BUCKETS);
+        EXPECT_LE(histogram::bucket_lo(idx), val);
+        EXPECT_GE(histogram::bucket_hi(idx), val);
+    }
+
+    for (size_t idx = 1; idx < histogram::NUM_BUCKETS; idx++) {
+        u64 lo = histogram::bucket_lo(idx);
+        EXPECT_EQ(lo, histogram::bucket_hi(idx - 1) + 1);
+        EXPECT_EQ(histogram::bucket_of(lo), idx);
+    }
+}
+
+TEST(histogram, percentiles) {
+    histogram h;
+    EXPECT_EQ(h.count(), 0);
+    EXPECT_EQ(h.percentile(50.0), 0);
+
+    for (u64 val = 1; val <= 1000; val++)
+        h.record(val);
+
+    EXPECT_EQ(h.count(), 1000);
+    EXPECT_EQ(h.min(), 1);
+    EXPECT_EQ(h.max(), 1000);
+    EXPECT_EQ(h.mean(), 500);
+
+    EXPECT_GE(h.percentile(50.0), 500);
+    EXPECT_LE(h.percentile(50.0), 500 * 9 / 8);
+    EXPECT_GE(h.percentile(99.0), 990);
+    EXPECT_LE(h.percentile(99.0), 1000);
+    EXPECT_EQ(h.percentile(100.0), 1000);
+
+    h.record(1000000);
+    EXPECT_GE(h.percentile(99.9), 1000);
+    EXPECT_LE(h.percentile(99.9), 1023);
+    EXPECT_EQ(h.percentile(100.0), 1000000);
+
+    h.reset();
+    EXPECT_EQ(h.count(), 0);
+    EXPECT_EQ(h.max(), 0);
+}
@@ -93,6 +93,106 @@ TEST(memory, move) {
     EXPECT_EQ(move.data(), data) << "memory pointer not moved";
 }
 
+TEST(memory, hugepages) {
+    tlm_memory thp;
+    thp.use_hugepages();
+    thp.prefault();
+    thp.init(4 * MiB, VCML_ALIGN_NONE);
+    EXPECT_TRUE(is_aligned(thp.data(), VCML_ALIGN_2M));
+    EXPECT_EQ(thp.page_size(), mwr::get_page_size());
+    thp[4 * MiB - 1] = 0x42;
+    EXPECT_EQ(thp[4 * MiB - 1], 0x42);
+
+    // must fall back to regular pages if no huge pages are reserved
+    tlm_memory hugetlb;
+    hugetlb.use_hugetlb();
+    hugetlb.init(4 * MiB, VCML_ALIGN_4K);
+    EXPECT_GE(hugetlb.page_size(), mwr::get_page_size());
+    EXPECT_TRUE(is_aligned(hugetlb.data(), VCML_ALIGN_4K));
+    hugetlb[4 * MiB - 1] = 0x42;
+    EXPECT_EQ(hugetlb[4 * MiB - 1], 0x42);
+}
+
+TEST(memory, map_file) {
+    const string path = "memory_map_file.bin";
+    vector<u8> image(3 * KiB);
+    for (size_t i = 0; i < image.size(); i++)
+        image[i] = (u8)i;
+
+    ofstream of(path.c_str(), std::ios::binary | std::ios::out);
+    of.write((const char*)image.data(), image.size());
+    of.close();
+
+    tlm_memory mem(64 * KiB);
+    mem.fill(0xee);
+
+    EXPECT_FALSE(mem.map_file(path, 1)) << "mapped unaligned offset";
+    EXPECT_FALSE(mem.map_file(path, 63 * KiB)) << "mapped out of bounds";
+    EXPECT_EQ(mem[63 * KiB], 0xee) << "failed mapping changed memory";
+
+    u64 offset = mem.page_size();
+    ASSERT_TRUE(mem.map_file(path, offset)) << "cannot map file";
+    for (size_t i = 0; i < image.size(); i++)
+        ASSERT_EQ(mem[offset + i], image[i]) << "mismatch at " << i;
+    EXPECT_EQ(mem[offset - 1], 0xee) << "mapping overwrote memory below";
+
+    mem[offset] = 0x42;
+    ASSERT_TRUE(mem.map_file(path, offset)) << "cannot remap file";
+    EXPECT_EQ(mem[offset], image[0]) << "remap did not discard writes";
+
+    ifstream file(path.c_str(), std::ios::binary);
+    EXPECT_EQ(file.get(), image[0]) << "write went through to file";
+    file.close();
+
+    std::remove(path.c_str());
+}
+
+TEST(memory, dirty_tracking) {
+    tlm_memory mem(64 * KiB);
+    mem.fill(0x11);
+
+    ASSERT_TRUE(mem.track_dirty()) << "cannot track dirty pages";
+    EXPECT_EQ(mem.count_dirty(), 0);
+
+    std::stringstream base;
+    EXPECT_EQ(mem.save_snapshot(base, true), mem.count_pages());
+
+    // writes through raw pointers, such as from DMI, must be tracked
+    size_t pgsz = mem.page_size();
+    u8* ptr = mem.data();
+    ptr[pgsz + 3] = 0x22;
+    ptr[3 * pgsz] = 0x33;
+    EXPECT_TRUE(mem.is_dirty(pgsz));
+    EXPECT_FALSE(mem.is_dirty(2 * pgsz));
+    EXPECT_TRUE(mem.is_dirty(3 * pgsz + 1));
+    EXPECT_EQ(mem.count_dirty(), 2);
+
+    std::stringstream incr;
+    EXPECT_EQ(mem.save_snapshot(incr), 2);
+    EXPECT_EQ(mem.count_dirty(), 0) << "snapshot did not checkpoint";
+
+    u32 val = 0x44444444;
+    EXPECT_OK(mem.write(3 * pgsz, val));
+    ptr[5 * pgsz] = 0x55;
+    EXPECT_EQ(mem.count_dirty(), 2);
+
+    // restore full base image plus first increment
+    ASSERT_TRUE(mem.load_snapshot(base));
+    ASSERT_TRUE(mem.load_snapshot(incr));
+    EXPECT_EQ(mem[pgsz + 3], 0x22);
+    EXPECT_EQ(mem[3 * pgsz], 0x33);
+    EXPECT_EQ(mem[3 * pgsz + 1], 0x11);
+    EXPECT_EQ(mem[5 * pgsz], 0x11);
+
+    std::stringstream junk("junk");
+    EXPECT_FALSE(mem.load_snapshot(junk));
+
+    EXPECT_TRUE(mem.track_dirty(false));
+    ptr[7 * pgsz] = 0x77;
+    EXPECT_FALSE(mem.is_dirty(7 * pgsz));
+    EXPECT_EQ(mem[7 * pgsz], 0x77);
+}
+
 TEST(memory, sharing) {
     const size_t size = 16 * KiB;
     const string name = "/vcml-test-shared";
@@ -112,3 +212,110 @@ TEST(memory, sharing_wrong_size) {
     EXPECT_DEATH({ tlm_memory b(name, size * 2); }, "unexpected size");
     EXPECT_DEATH({ tlm_memory b(name, size / 2); }, "unexpected size");
 }
+
+TEST(memory, streaming) {
+    tlm_memory mem(16);
+    for (size_t i = 0; i < mem.size(); i++)
+        mem[i] = (u8)i;
+
+    u8 buffer[8] = {};
+    tlm_generic_payload tx;
+    tx_setup(tx, TLM_READ_COMMAND, 4, buffer, sizeof(buffer));
+    tx.set_streaming_width(2);
+    EXPECT_EQ(mem.transport(tx, SBI_NONE), sizeof(buffer));
+    EXPECT_OK(tx.get_response_status());
+    for (size_t i = 0; i < sizeof(buffer); i++)
+        EXPECT_EQ(buffer[i], 4 + i % 2) << "mismatch at position " << i;
+
+    u8 data[6] = { 0x11, 0x22, 0x33, 0x44, 0x55, 0x66 };
+    tx_setup(tx, TLM_WRITE_COMMAND, 0, data, sizeof(data));
+    tx.set_streaming_width(2);
+    EXPECT_EQ(mem.transport(tx, SBI_NONE), sizeof(data));
+    EXPECT_OK(tx.get_response_status());
+    EXPECT_EQ(mem[0], 0x55);
+    EXPECT_EQ(mem[1], 0x66);
+    EXPECT_EQ(mem[2], 2);
+
+    tx_setup(tx, TLM_WRITE_COMMAND, 0, data, sizeof(data));
+    tx.set_streaming_width(4);
+    mem.transport(tx, SBI_NONE);
+    EXPECT_EQ(tx.get_response_status(), TLM_BURST_ERROR_RESPONSE);
+
+    tx_setup(tx, TLM_READ_COMMAND, 15, buffer, sizeof(buffer));
+    tx.set_streaming_width(2);
+    EXPECT_EQ(mem.transport(tx, SBI_NONE), 0);
+    EXPECT_AE(tx.get_response_status());
+}
+
+TEST(memory, byte_enable) {
+    tlm_memory mem(64);
+    mem.fill(0xee);
+
+    u8 data[40];
+    for (size_t i = 0; i < sizeof(data); i++)
+        data[i] = (u8)i;
+
+    u8 be[3] = { TLM_BYTE_ENABLED, TLM_BYTE_DISABLED, TLM_BYTE_ENABLED };
+    tlm_generic_payload tx;
+    tx_setup(tx, TLM_WRITE_COMMAND, 8, data, sizeof(data));
+    tx.set_byte_enable_ptr(be);
+    tx.set_byte_enable_length(sizeof(be));
+    EXPECT_EQ(mem.transport(tx, SBI_NONE), 27);
+    EXPECT_OK(tx.get_response_status());
+
+    for (size_t i = 0; i < sizeof(data); i++) {
+        u8 expect = (i % 3 == 1) ? 0xee : data[i];
+        EXPECT_EQ(mem[8 + i], expect) << "mismatch at position " << i;
+    }
+
+    EXPECT_EQ(mem[7], 0xee) << "write below byte enable range";
+    EXPECT_EQ(mem[48], 0xee) << "write above byte enable range";
+
+    u8 buffer[40];
+    memset(buffer, 0xcc, sizeof(buffer));
+    tx_setup(tx, TLM_READ_COMMAND, 8, buffer, sizeof(buffer));
+    tx.set_byte_enable_ptr(be);
+    tx.set_byte_enable_length(sizeof(be));
+    mem.transport(tx, SBI_NONE);
+    EXPECT_OK(tx.get_response_status());
+
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        u8 expect = (i % 3 == 1) ? 0xcc : data[i];
+        EXPECT_EQ(buffer[i], expect) << "mismatch at position " << i;
+    }
+}
+
+TEST(memory, scatter_gather) {
+    tlm_memory mem(256);
+    for (size_t i = 0; i < mem.size(); i++)
+        mem[i] = (u8)i;
+
+    u8 a[4] = {}, b[8] = {}, c[2] = {};
+    vector<tlm_sg_segment> segments = {
+        { 0x1080, b, sizeof(b) },
+        { 0x10fe, c, sizeof(c) },
+        { 0x1100, c, sizeof(c) }, // out of bounds
+    };
+
+    // initiator sees memory at 0x1000, target at 0x0
+    sgext ext(0x1010, segments);
+    tlm_generic_payload tx;
+    tx_setup(tx, TLM_READ_COMMAND, 0x10, a, sizeof(a));
+    tx.set_extension(&ext);
+    EXPECT_EQ(mem.transport(tx, SBI_NONE), 14);
+    tx.clear_extension(&ext);
+
+    EXPECT_OK(tx.get_response_status());
+    EXPECT_EQ(ext.completed, 2);
+    EXPECT_EQ(a[0], 0x10);
+    EXPECT_EQ(b[7], 0x87);
+    EXPECT_EQ(c[0], 0xfe);
+    EXPECT_EQ(c[1], 0xff);
+
+    ext.limit = 1;
+    tx_setup(tx, TLM_WRITE_COMMAND, 0x10, a, sizeof(a));
+    tx.set_extension(&ext);
+    EXPECT_EQ(mem.transport(tx, SBI_NONE), 12);
+    tx.clear_extension(&ext);
+    EXPECT_EQ(ext.completed, 1);
+}
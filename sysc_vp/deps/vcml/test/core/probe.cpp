@@ -43,6 +43,31 @@ public:
 
         EXPECT_CALL(*this, receive(TLM_READ_COMMAND, 0x5678));
         EXPECT_OK(out.readw(0x5678, data));
+
+        u8 buffer[32] = {};
+        EXPECT_CALL(*this, receive(TLM_READ_COMMAND, 0x9abc));
+        EXPECT_OK(out.read(0x9abc, buffer, sizeof(buffer), SBI_DEBUG));
+
+        const tlm_probe_stats& stats = probe.stats();
+        EXPECT_EQ(stats.num_b_transport, 2);
+        EXPECT_EQ(stats.num_transport_dbg, 1);
+        EXPECT_EQ(stats.num_reads(), 1);
+        EXPECT_EQ(stats.num_writes(), 1);
+        EXPECT_EQ(stats.reads[tlm_probe_stats::size_class(4)], 1);
+        EXPECT_EQ(stats.writes[tlm_probe_stats::size_class(4)], 1);
+        EXPECT_EQ(stats.num_errors, 0);
+        EXPECT_EQ(stats.delays[0], 2);
+
+        std::stringstream ss;
+        EXPECT_TRUE(probe.execute("stats", ss));
+        EXPECT_NE(ss.str().find("2 b_transport"), string::npos) << ss.str();
+
+        std::stringstream json;
+        probe.write_json(json);
+        EXPECT_NE(json.str().find("\"b_transport\": 2"), string::npos);
+
+        probe.reset_stats();
+        EXPECT_EQ(probe.stats().num_b_transport, 0);
     }
 };
 
@@ -0,0 +1,80 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "testing.h"
+
+SC_MODULE(profile_test) {
+    sc_event tick;
+    size_t busy_runs;
+    size_t idle_runs;
+
+    SC_CTOR(profile_test): tick("tick"), busy_runs(0), idle_runs(0) {
+        SC_METHOD(busy);
+        sensitive << tick;
+        dont_initialize();
+        SC_METHOD(idle);
+        sensitive << tick;
+        dont_initialize();
+        SC_THREAD(run);
+    }
+
+    void busy() {
+        busy_runs++;
+        u64 start = mwr::timestamp_ns();
+        while (mwr::timestamp_ns() - start < 100000) {
+            // burn host time
+        }
+    }
+
+    void idle() { idle_runs++; }
+
+    void run() {
+        for (int i = 0; i < 10; i++) {
+            tick.notify(SC_ZERO_TIME);
+            wait(10, SC_NS);
+        }
+
+        sc_stop();
+    }
+};
+
+TEST(sc_profile, processes) {
+    profile_test test("test");
+    sc_core::sc_start();
+
+    EXPECT_EQ(test.busy_runs, 10);
+    EXPECT_EQ(test.idle_runs, 10);
+
+    std::stringstream ss;
+    sc_core::sc_print_process_profile(ss, 3);
+    std::cout << ss.str();
+
+    vector<sc_core::sc_process_profile> profile;
+    profile = sc_core::sc_get_process_profile();
+
+    if (!sc_core::sc_process_profiling_enabled()) {
+        EXPECT_TRUE(profile.empty());
+        EXPECT_NE(ss.str().find("disabled"), string::npos);
+        return;
+    }
+
+    ASSERT_GE(profile.size(), 3);
+    EXPECT_EQ(profile[0].name, "test.busy");
+    EXPECT_EQ(profile[0].kind, sc_core::SC_METHOD_PROC_);
+    EXPECT_EQ(profile[0].activations, 10);
+    EXPECT_GE(profile[0].host_time_ns, 10 * 100000);
+    EXPECT_NE(ss.str().find("test.busy"), string::npos);
+
+    sc_core::sc_reset_process_profile();
+    for (const auto& entry : sc_core::sc_get_process_profile()) {
+        EXPECT_EQ(entry.activations, 0);
+        EXPECT_EQ(entry.host_time_ns, 0);
+    }
+}
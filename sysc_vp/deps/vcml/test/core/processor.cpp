@@ -151,4 +151,13 @@ TEST(processor, processor) {
     EXPECT_CALL(cpu, handle_clock_update(0, DEFCLK)).Times(1);
     cpu.clk_out = DEFCLK;
     sc_core::sc_start(10 * quantum);
+
+    // test halted processors skip ahead to the next pending activity
+    sc_core::sc_event wakeup;
+    wakeup.notify(5 * quantum);
+    cpu.set_running(false);
+    EXPECT_CALL(cpu, simulate2(_)).Times(0);
+    sc_core::sc_start(quantum);
+    EXPECT_GE(sc_core::sc_time_to_pending_activity(), 3 * quantum);
+    cpu.set_running(true);
 }
@@ -0,0 +1,75 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "testing.h"
+using namespace ::vcml::debugging;
+
+TEST(profiler, flat) {
+    symtab syms;
+    syms.insert(symbol("a", SYMKIND_FUNCTION, ENDIAN_LITTLE, 0x40, 0x100, 0));
+    syms.insert(symbol("b", SYMKIND_FUNCTION, ENDIAN_LITTLE, 0x40, 0x200, 0));
+
+    profiler prof(syms);
+    for (u64 pc = 0x100; pc < 0x110; pc += 4)
+        prof.sample(pc);
+    prof.sample(0x204);
+    prof.sample(0x204);
+    prof.sample(0x300);
+
+    EXPECT_EQ(prof.samples(), 7);
+    EXPECT_EQ(prof.hits(0x204), 2);
+    EXPECT_EQ(prof.hits(0x208), 0);
+
+    stringstream ss;
+    prof.write_flat(ss);
+    EXPECT_EQ(ss.str(),
+              "samples: 7\n"
+              "      %    samples  function\n"
+              "  57.14          4  a\n"
+              "  28.57          2  b\n"
+              "  14.29          1  0x0000000000000300\n");
+
+    stringstream top;
+    prof.write_flat(top, 1);
+    EXPECT_EQ(top.str().find("  b\n"), string::npos);
+
+    prof.reset();
+    EXPECT_EQ(prof.samples(), 0);
+    EXPECT_EQ(prof.hits(0x204), 0);
+}
+
+TEST(profiler, folded) {
+    symbol a("a", SYMKIND_FUNCTION, ENDIAN_LITTLE, 0x40, 0x100, 0);
+    symbol b("b", SYMKIND_FUNCTION, ENDIAN_LITTLE, 0x40, 0x200, 0);
+    symtab syms;
+    syms.insert(a);
+    syms.insert(b);
+
+    vector<stackframe> frames = {
+        { 0x204, 0, syms.find_function(0x204) },
+        { 0x108, 0, syms.find_function(0x108) },
+    };
+
+    profiler prof(syms);
+    prof.sample(frames);
+    prof.sample(frames);
+
+    frames[0] = { 0x300, 0, nullptr };
+    prof.sample(frames);
+
+    EXPECT_EQ(prof.samples(), 3);
+    EXPECT_EQ(prof.hits(0x204), 2);
+
+    stringstream ss;
+    prof.write_folded(ss);
+    string folded = ss.str();
+    EXPECT_NE(folded.find("a;b 2\n"), string::npos);
+    EXPECT_NE(folded.find("a;0x0000000000000300 1\n"), string::npos);
+}
@@ -0,0 +1,77 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "testing.h"
+
+class replay_test : public test_base
+{
+public:
+    string file;
+    vector<pair<sc_time, string>> received;
+
+    replay_test(const sc_module_name& nm = sc_gen_unique_name("test")):
+        test_base(nm),
+        file(mwr::temp_dir() + "/vcml_replay.bin"),
+        received() {
+        replay::instance().attach("chan_a", [&](const vector<u8>& data) {
+            received.push_back({ sc_time_stamp(), "a:" + to_str(data) });
+        });
+
+        replay::instance().attach("chan_b", [&](const vector<u8>& data) {
+            received.push_back({ sc_time_stamp(), "b:" + to_str(data) });
+        });
+    }
+
+    virtual ~replay_test() {
+        replay::instance().detach("chan_a");
+        replay::instance().detach("chan_b");
+        std::remove(file.c_str());
+    }
+
+    static string to_str(const vector<u8>& data) {
+        return string(data.begin(), data.end());
+    }
+
+    virtual void run_test() override {
+        replay& rep = replay::instance();
+        rep.start_recording(file);
+        EXPECT_TRUE(rep.is_recording());
+
+        wait(10, SC_NS);
+        rep.record("chan_a", "hello", 5);
+        wait(15, SC_NS);
+        rep.record("chan_b", "x", 1);
+        rep.record("chan_a", "world", 5);
+        EXPECT_EQ(rep.num_events(), 3);
+
+        rep.stop();
+        EXPECT_FALSE(rep.is_recording());
+
+        // all recorded times have passed, so events replay immediately but
+        // must still arrive in order and on the right channels
+        rep.start_playback(file);
+        EXPECT_TRUE(rep.is_replaying());
+        wait(10, SC_NS);
+
+        ASSERT_EQ(received.size(), 3);
+        EXPECT_EQ(received[0].second, "a:hello");
+        EXPECT_EQ(received[1].second, "b:x");
+        EXPECT_EQ(received[2].second, "a:world");
+        for (const auto& ev : received)
+            EXPECT_EQ(ev.first, sc_time(25, SC_NS));
+        EXPECT_EQ(rep.num_events(), 3);
+        rep.stop();
+    }
+};
+
+TEST(replay, record_playback) {
+    replay_test test;
+    sc_core::sc_start();
+}
@@ -0,0 +1,70 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include "testing.h"
+
+static const size_t STACK_SIZE = 512 * KiB;
+
+static void __attribute__((noinline)) touch_stack(size_t size) {
+    volatile char buffer[256 * KiB];
+    for (size_t i = 0; i < size && i < sizeof(buffer); i += 64)
+        buffer[i] = (char)i;
+}
+
+SC_MODULE(stacks_test) {
+    vector<size_t> usage;
+
+    SC_CTOR(stacks_test): usage() { SC_THREAD(run); }
+
+    void worker(size_t touch) {
+        touch_stack(touch);
+        usage.push_back(sc_stack_usage(sc_get_current_process_handle()));
+    }
+
+    void spawn_worker(size_t touch) {
+        sc_spawn_options opts;
+        opts.set_stack_size(STACK_SIZE);
+        sc_process_handle h = sc_spawn([this, touch]() { worker(touch); },
+                                       nullptr, &opts);
+        EXPECT_EQ(sc_stack_size(h), STACK_SIZE);
+        wait(h.terminated_event());
+        wait(1, SC_NS); // allow the kernel to collect the process
+    }
+
+    void run() {
+        sc_process_handle self = sc_get_current_process_handle();
+        EXPECT_GT(sc_stack_size(self), 0);
+        EXPECT_GT(sc_stack_usage(self), 0);
+        EXPECT_LE(sc_stack_usage(self), sc_stack_size(self));
+
+        spawn_worker(200 * KiB);
+        spawn_worker(0);
+        spawn_worker(0);
+
+        // stacks are recycled, but their old contents must not count
+        // towards the stack usage of their new owners
+        ASSERT_EQ(usage.size(), 3);
+        EXPECT_GE(usage[0], 200 * KiB);
+        EXPECT_LT(usage[0], STACK_SIZE);
+        EXPECT_LT(usage[1], 64 * KiB);
+        EXPECT_LT(usage[2], 64 * KiB);
+
+        std::stringstream ss;
+        sc_print_stack_usage(ss);
+        EXPECT_NE(ss.str().find("stacks.run: "), string::npos) << ss.str();
+
+        sc_stop();
+    }
+};
+
+TEST(stacks, usage) {
+    stacks_test test("stacks");
+    sc_core::sc_start();
+}
@@ -55,6 +55,37 @@ public:
 
         t1.join();
         t2.join();
+
+        vector<pair<int, int>> jobs;
+        vector<std::thread> posters;
+        atomic<int> posted[4] = {};
+        atomic<int> calls(0);
+        for (int id = 0; id < 4; id++) {
+            posters.emplace_back([&, id]() -> void {
+                for (int i = 0; i < 100; i++) {
+                    thctl_post([&, id, i]() -> void {
+                        EXPECT_TRUE(thctl_is_sysc_thread());
+                        jobs.push_back({ id, i });
+                        posted[id]++;
+                    });
+                }
+
+                // calls complete only after all previously posted jobs
+                thctl_call([&]() -> void { calls++; });
+                EXPECT_EQ(posted[id], 100);
+            });
+        }
+
+        while (calls < 4)
+            wait(SC_ZERO_TIME);
+
+        for (auto& t : posters)
+            t.join();
+
+        ASSERT_EQ(jobs.size(), 400);
+        int next[4] = { 0, 0, 0, 0 };
+        for (auto job : jobs)
+            EXPECT_EQ(job.second, next[job.first]++);
     }
 };
 
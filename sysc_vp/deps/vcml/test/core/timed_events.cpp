@@ -0,0 +1,207 @@
+/******************************************************************************
+ *                                                                            *
+ * Copyright (C) 2022 MachineWare GmbH                                        *
+ * All Rights Reserved                                                        *
+ *                                                                            *
+ * This is work is licensed under the terms described in the LICENSE file     *
+ * found in the root directory of this source tree.                           *
+ *                                                                            *
+ ******************************************************************************/
+
+#include <random>
+
+#include "testing.h"
+
+struct timer {
+    u64 time;
+    u64 order;
+    size_t id;
+    bool live;
+    int m_heap_index;
+
+    static bool heap_before(const timer* a, const timer* b) {
+        if (a->time != b->time)
+            return a->time < b->time;
+        return a->order < b->order;
+    }
+
+    static int compare(const void* p1, const void* p2) {
+        const timer* a = (const timer*)p1;
+        const timer* b = (const timer*)p2;
+        return heap_before(a, b) ? 1 : heap_before(b, a) ? -1 : 0;
+    }
+};
+
+template <int D>
+static void check_ordering() {
+    std::mt19937 rng(D);
+    vector<timer> timers(512);
+    vector<timer*> queued;
+    sc_core::sc_dpq<timer, D> pq(4);
+
+    u64 order = 0;
+    for (timer& t : timers) {
+        t.time = rng() % 1000;
+        t.order = order++;
+        pq.insert(&t);
+        queued.push_back(&t);
+    }
+
+    // remove every third element from the middle of the queue
+    for (size_t i = 0; i < queued.size(); i += 3) {
+        pq.remove(queued[i]);
+        EXPECT_EQ(queued[i]->m_heap_index, -1);
+    }
+
+    ASSERT_EQ(pq.size(), 512 - 171);
+
+    const timer* prev = nullptr;
+    while (!pq.empty()) {
+        const timer* t = pq.extract_top();
+        EXPECT_NE(t->order % 3, 0u);
+        if (prev) {
+            EXPECT_TRUE(timer::heap_before(prev, t));
+        }
+        prev = t;
+    }
+}
+
+TEST(timed_events, ordering) {
+    check_ordering<2>();
+    check_ordering<4>();
+    check_ordering<8>();
+}
+
+// Timer-heavy workload: each step fires the earliest timer and re-arms it,
+// and every other step reprograms some pending timer to an earlier time,
+// the way a peripheral timer reacts to a register write.
+static const size_t NUM_TIMERS = 1024;
+static const size_t NUM_STEPS = 100000;
+
+// sc_ppq cannot remove from the middle, so cancelled entries stay queued
+// until they reach the top; this is how the kernel used to handle them
+static void cancel(sc_core::sc_ppq<timer*>& pq, timer* t) {
+    t->live = false;
+}
+
+template <int D>
+static void cancel(sc_core::sc_dpq<timer, D>& pq, timer* t) {
+    pq.remove(t);
+}
+
+template <typename QUEUE>
+static double run_workload(QUEUE& pq) {
+    std::mt19937 rng(42);
+    deque<timer> pool;
+    vector<timer*> armed(NUM_TIMERS);
+
+    u64 order = 0;
+    auto arm = [&](size_t id, u64 when) -> void {
+        pool.push_back({ when, order++, id, true, -1 });
+        armed[id] = &pool.back();
+        pq.insert(armed[id]);
+    };
+
+    for (size_t id = 0; id < NUM_TIMERS; id++)
+        arm(id, rng() % 10000);
+
+    u64 start = mwr::timestamp_ns();
+    for (size_t step = 0; step < NUM_STEPS; step++) {
+        timer* t = pq.extract_top();
+        while (!t->live)
+            t = pq.extract_top();
+
+        u64 now = t->time;
+        arm(t->id, now + 1 + rng() % 10000);
+
+        if (step % 2) {
+            size_t other = rng() % NUM_TIMERS;
+            timer* old = armed[other];
+            if (old->time > now + 1) {
+                cancel(pq, old);
+                arm(other, now + 1 + rng() % (old->time - now));
+            }
+        }
+
+        if (pool.size() > 64 * NUM_TIMERS) {
+            // keep the pool bounded, pending timers are re-armed below
+            while (!pq.empty())
+                pq.extract_top();
+            pool.clear();
+            for (size_t i = 0; i < NUM_TIMERS; i++)
+                arm(i, now + 1 + rng() % 10000);
+        }
+    }
+
+    return (double)(mwr::timestamp_ns() - start) / NUM_STEPS;
+}
+
+TEST(timed_events, benchmark) {
+    sc_core::sc_ppq<timer*> ppq(128, timer::compare);
+    sc_core::sc_dpq<timer, 2> dpq2;
+    sc_core::sc_dpq<timer, 4> dpq4;
+    sc_core::sc_dpq<timer, 8> dpq8;
+
+    std::cout << "sc_ppq (lazy cancel): " << run_workload(ppq)
+              << "ns/step" << std::endl;
+    std::cout << "sc_dpq<2>: " << run_workload(dpq2) << "ns/step"
+              << std::endl;
+    std::cout << "sc_dpq<4>: " << run_workload(dpq4) << "ns/step"
+              << std::endl;
+    std::cout << "sc_dpq<8>: " << run_workload(dpq8) << "ns/step"
+              << std::endl;
+}
+
+SC_MODULE(timed_events_test) {
+    sc_event ev;
+    vector<sc_time> fired;
+
+    SC_CTOR(timed_events_test): ev("ev"), fired() {
+        SC_METHOD(on_event);
+        sensitive << ev;
+        dont_initialize();
+        SC_THREAD(run);
+    }
+
+    void on_event() { fired.push_back(sc_time_stamp()); }
+
+    void run() {
+        // an earlier notification overrides a later one
+        ev.notify(20, SC_NS);
+        ev.notify(10, SC_NS);
+        ev.notify(30, SC_NS);
+        EXPECT_EQ(sc_time_to_pending_activity(), sc_time(10, SC_NS));
+        wait(50, SC_NS);
+        ASSERT_EQ(fired.size(), 1);
+        EXPECT_EQ(fired[0], sc_time(10, SC_NS));
+
+        // cancelled notifications leave no pending activity behind
+        ev.notify(10, SC_NS);
+        ev.cancel();
+        EXPECT_FALSE(sc_pending_activity_at_future_time());
+
+        // a delta notification replaces a pending timed one
+        ev.notify(10, SC_NS);
+        ev.notify(SC_ZERO_TIME);
+        EXPECT_FALSE(sc_pending_activity_at_future_time());
+        wait(50, SC_NS);
+        ASSERT_EQ(fired.size(), 2);
+        EXPECT_EQ(fired[1], sc_time(50, SC_NS));
+
+        // notifications for the same time fire in the order they were made
+        sc_event a("a"), b("b");
+        a.notify(5, SC_NS);
+        b.notify(5, SC_NS);
+        wait(a | b);
+        EXPECT_TRUE(a.triggered());
+        EXPECT_TRUE(b.triggered());
+
+        sc_stop();
+    }
+};
+
+TEST(timed_events, kernel) {
+    timed_events_test test("test");
+    sc_core::sc_start();
+    EXPECT_EQ(sc_core::sc_get_status(), sc_core::SC_STOPPED);
+}
@@ -80,3 +80,64 @@ TEST(tlm, base_sockets) {
     tlm_harness test("tlm");
     sc_core::sc_start();
 }
+
+TEST(tlm, mm) {
+    tlm_mm mm;
+    tlm_generic_payload* tx = mm.allocate();
+    ASSERT_NE(tx, nullptr);
+    EXPECT_TRUE(tx->has_mm());
+    EXPECT_EQ(tx->get_ref_count(), 1);
+    EXPECT_TRUE(tx_has_sbi(*tx));
+    EXPECT_EQ(mm.size(), 1);
+    EXPECT_EQ(mm.available(), 0);
+
+    tx->acquire();
+    tx->release();
+    EXPECT_EQ(mm.available(), 0);
+    tx->release();
+    EXPECT_EQ(mm.available(), 1);
+
+    tlm_generic_payload* tx2 = mm.allocate();
+    EXPECT_EQ(tx2, tx) << "payload not recycled";
+    EXPECT_TRUE(tx_has_sbi(*tx2));
+
+    tlm_generic_payload* tx3 = mm.allocate();
+    EXPECT_NE(tx3, tx2);
+    EXPECT_EQ(mm.size(), 2);
+
+    tx2->release();
+    tx3->release();
+    EXPECT_EQ(mm.available(), 2);
+}
+
+TEST(tlm, sync_stats) {
+    const sc_time quantum(10, SC_US);
+
+    tlm_sync_stats stats;
+    EXPECT_EQ(stats.suggest_quantum(quantum), quantum);
+
+    stats.count(TLM_SYNC_QUANTUM, sc_time(12, SC_US), quantum);
+    stats.count(TLM_SYNC_QUANTUM, sc_time(10, SC_US), quantum);
+    stats.count(TLM_SYNC_TRANSACTION, sc_time(1, SC_US), quantum);
+    EXPECT_EQ(stats.num_syncs(), 3);
+    EXPECT_EQ(stats.num_forced_syncs(), 1);
+    EXPECT_EQ(stats.num_overshoots, 1);
+    EXPECT_EQ(stats.max_overshoot, sc_time(2, SC_US));
+    EXPECT_EQ(stats.mean_forced_offset(), sc_time(1, SC_US));
+
+    // mostly quantum syncs: more decoupling helps
+    EXPECT_EQ(stats.suggest_quantum(quantum), sc_time(20, SC_US));
+
+    // mostly forced after ~1.5us: the quantum rarely matters
+    for (int i = 0; i < 7; i++)
+        stats.count(TLM_SYNC_REGISTER, sc_time(1500, SC_NS), quantum);
+    EXPECT_EQ(stats.suggest_quantum(quantum), sc_time(5, SC_US));
+
+    stringstream ss;
+    stats.print(ss, quantum);
+    EXPECT_NE(ss.str().find("register: 7"), string::npos);
+
+    stats.reset();
+    EXPECT_EQ(stats.num_syncs(), 0);
+    EXPECT_EQ(stats.num_overshoots, 0);
+}
@@ -63,6 +63,27 @@ public:
 
         ASSERT_TRUE(is_aligned(ram.data(), VCML_ALIGN_2M))
             << "memory is not 21 bit aligned";
+
+        u8 a[4] = { 1, 2, 3, 4 };
+        u8 b[4] = { 5, 6, 7, 8 };
+        vector<tlm_sg_segment> segments = {
+            { 0x100, a, sizeof(a) },
+            { 0x200, b, sizeof(b) },
+        };
+
+        ASSERT_OK(ram_port.access_sg(TLM_WRITE_COMMAND, segments, SBI_NODMI))
+            << "cannot write scatter-gather list";
+        EXPECT_EQ(ram[0x103], 4) << "first segment not written";
+        EXPECT_EQ(ram[0x203], 8) << "second segment not written";
+
+        u8 beat[16];
+        tlm_generic_payload tx;
+        tx_setup(tx, TLM_READ_COMMAND, 0x200, beat, sizeof(beat));
+        tx.set_streaming_width(4);
+        ASSERT_EQ(ram_port.send(tx, SBI_NODMI), sizeof(beat));
+        ASSERT_OK(tx.get_response_status()) << "streaming read failed";
+        for (size_t i = 0; i < sizeof(beat); i++)
+            EXPECT_EQ(beat[i], b[i % 4]) << "streaming read mismatch";
     }
 };
 
@@ -224,18 +224,17 @@ void PydrofoilCore::python_worker_loop(){
 
 bool PydrofoilCore::get_dmi_ptr(tlm::tlm_command cmd, uint64_t addr)
 {
-    tlm::tlm_generic_payload tx;
-    tx.set_command(cmd);
-    tx.set_address(addr);
-    tx.set_data_length(1);
-    tx.set_dmi_allowed(true);
-
-    sc_core::sc_time delay = sc_core::SC_ZERO_TIME;
-    if (data.get_interface()) { // it ensures that the socket is actually bound to something 
-        if (data->get_direct_mem_ptr(tx, dmi_cache))
-            return true;
-    }
-    return false;
+    if (!data.get_interface()) // it ensures that the socket is actually bound to something
+        return false;
+
+    // recycled payload from the socket pool, no allocation per request
+    tlm::tlm_generic_payload* tx = data.alloc_payload();
+    vcml::tx_setup(*tx, cmd, addr, nullptr, 1);
+    tx->set_dmi_allowed(true);
+
+    bool granted = data->get_direct_mem_ptr(*tx, dmi_cache);
+    tx->release();
+    return granted;
 }
 
 